@@ -28,6 +28,10 @@
 
 #include <stdint.h>
 
+#if defined(CHI32_ENABLE_METRICS)
+#include "chi32_metrics.h"
+#endif
+
 // === Internal helper functions (Static Inline) ===
 
 /**
@@ -50,6 +54,23 @@ static inline uint64_t chi32_internal_rotate_left_u64(uint64_t x, int k) {
     return (x << k) | (x >> (64 - k));
 }
 
+/**
+ * @brief Truncates a 64-bit intermediate state through the state-dependent 32-bit extraction window.
+ * @param state_u64 Intermediate state produced by chi32_apply_cascading_hash_interleave.
+ * @return The derived 32-bit value.
+ */
+static inline int32_t chi32_internal_extract_value(uint64_t state_u64) {
+    uint32_t low_bits_for_xor = (uint32_t)state_u64;
+    uint32_t mid_bits_for_xor = (uint32_t)(state_u64 >> 29);
+    uint32_t high_bits_for_xor = (uint32_t)(state_u64 >> 58);
+
+    int offset = (int)((low_bits_for_xor ^ mid_bits_for_xor ^ high_bits_for_xor) & 0x3FU); // 0x3F is 63
+
+    uint64_t rotated_state_u64 = chi32_internal_rotate_left_u64(state_u64, offset);
+
+    return (int32_t)rotated_state_u64;
+}
+
 // === CHI32 algorithm implementation (Static Inline) ===
 
 /**
@@ -151,17 +172,11 @@ static inline int64_t chi32_apply_cascading_hash_interleave(int64_t selector, in
  * @return An int32_t representing the pseudo-random value.
  */
 static inline int32_t chi32_derive_value_at(int64_t selector, int64_t index) {
-    uint64_t state_u64 = (uint64_t)chi32_apply_cascading_hash_interleave(selector, index);
-
-    uint32_t low_bits_for_xor = (uint32_t)state_u64;
-    uint32_t mid_bits_for_xor = (uint32_t)(state_u64 >> 29);
-    uint32_t high_bits_for_xor = (uint32_t)(state_u64 >> 58);
+#if defined(CHI32_ENABLE_METRICS)
+    CHI32_METRICS_RECORD(CHI32_METRICS_API_SCALAR, 1);
+#endif
 
-    int offset = (int)((low_bits_for_xor ^ mid_bits_for_xor ^ high_bits_for_xor) & 0x3FU); // 0x3F is 63
-
-    uint64_t rotated_state_u64 = chi32_internal_rotate_left_u64(state_u64, offset);
-
-    return (int32_t)rotated_state_u64;
+    return chi32_internal_extract_value((uint64_t)chi32_apply_cascading_hash_interleave(selector, index));
 }
 
 #endif // CHI32_H
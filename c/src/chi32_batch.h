@@ -0,0 +1,285 @@
+#ifndef CHI32_BATCH_H
+#define CHI32_BATCH_H
+
+// MIT License
+//
+// Copyright (c) 2025 Janusz Pelc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Batch (multi-value) helpers built on top of the CHI32 core primitives.
+// Every function in this file is bit-for-bit equivalent to calling the scalar
+// primitives from chi32.h in a loop; only the execution strategy differs.
+//
+// When compiled with AVX2 enabled (e.g. -mavx2 or -march=native), eight values
+// are computed per step using 256-bit vectors. Otherwise a portable scalar loop
+// is used. Define CHI32_BATCH_DISABLE_SIMD to force the scalar path.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "chi32.h"
+#include "chi32_metrics.h"
+
+#if defined(__AVX2__) && !defined(CHI32_BATCH_DISABLE_SIMD)
+#define CHI32_BATCH_USE_AVX2 1
+#include <immintrin.h>
+#else
+#define CHI32_BATCH_USE_AVX2 0
+#endif
+
+/**
+ * @brief Number of values processed per step by the vectorized kernel.
+ */
+#define CHI32_BATCH_LANE_COUNT 8
+
+// === Internal helper functions (Static Inline) ===
+
+#if CHI32_BATCH_USE_AVX2
+
+/**
+ * @brief Eight-lane equivalent of chi32_update_hash_value.
+ * @param hash_u32x8 Eight prior hash values.
+ * @param value_u32x8 Eight input values.
+ * @return Eight updated hash values.
+ */
+static inline __m256i chi32_internal_update_hash_value_x8(__m256i hash_u32x8, __m256i value_u32x8) {
+    const __m256i prime_number_1 = _mm256_set1_epi32((int32_t)0x8addb2d1U);
+    const __m256i prime_number_2 = _mm256_set1_epi32((int32_t)0x8c723b45U);
+    const __m256i prime_number_3 = _mm256_set1_epi32((int32_t)0xfd923173U);
+    const __m256i prime_number_4 = _mm256_set1_epi32((int32_t)0x89a6aa0bU);
+    const __m256i prime_number_5 = _mm256_set1_epi32((int32_t)0x1f844cb7U);
+    const __m256i prime_number_6 = _mm256_set1_epi32((int32_t)0xfd2c1e9dU);
+    const __m256i rotate_mask = _mm256_set1_epi32(0x1F);
+    const __m256i rotate_width = _mm256_set1_epi32(32);
+
+    __m256i hash = _mm256_xor_si256(hash_u32x8, prime_number_1);
+
+    // A variable shift by 32 yields zero, so a rotate amount of 0 behaves like the scalar version.
+    __m256i rotate_amount = _mm256_and_si256(hash, rotate_mask);
+    __m256i rotated_value = _mm256_or_si256(_mm256_sllv_epi32(value_u32x8, rotate_amount),
+                                            _mm256_srlv_epi32(value_u32x8, _mm256_sub_epi32(rotate_width, rotate_amount)));
+    hash = _mm256_add_epi32(hash, _mm256_xor_si256(prime_number_2, rotated_value));
+    hash = _mm256_mullo_epi32(hash, prime_number_3);
+
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 15));
+    hash = _mm256_mullo_epi32(hash, prime_number_4);
+
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 7));
+    hash = _mm256_add_epi32(hash, _mm256_srli_epi32(hash, 29));
+    hash = _mm256_mullo_epi32(hash, prime_number_5);
+
+    hash = _mm256_xor_si256(hash, _mm256_srli_epi32(hash, 16));
+    hash = _mm256_mullo_epi32(hash, prime_number_6);
+
+    return hash;
+}
+
+/**
+ * @brief Multiplies four unsigned 64-bit lanes by a 64-bit constant (modulo 2^64).
+ * @param value_u64x4 Four 64-bit values.
+ * @param multiplier 64-bit multiplier.
+ * @return Four 64-bit products.
+ */
+static inline __m256i chi32_internal_multiply_u64x4(__m256i value_u64x4, uint64_t multiplier) {
+    const __m256i multiplier_low = _mm256_set1_epi64x((int64_t)(multiplier & 0xFFFFFFFFULL));
+    const __m256i multiplier_high = _mm256_set1_epi64x((int64_t)(multiplier >> 32));
+
+    __m256i low_product = _mm256_mul_epu32(value_u64x4, multiplier_low);
+    __m256i cross_product = _mm256_add_epi64(_mm256_mul_epu32(value_u64x4, multiplier_high),
+                                             _mm256_mul_epu32(_mm256_srli_epi64(value_u64x4, 32), multiplier_low));
+
+    return _mm256_add_epi64(low_product, _mm256_slli_epi64(cross_product, 32));
+}
+
+/**
+ * @brief Eight-lane equivalent of chi32_apply_cascading_hash_interleave for a shared selector.
+ *
+ * Lanes 0-3 come from 'index_low_x4' and lanes 4-7 from 'index_high_x4'; the two
+ * output vectors follow the same layout.
+ *
+ * @param selector Sequence selector shared by all lanes.
+ * @param index_low_x4 Indices for lanes 0-3.
+ * @param index_high_x4 Indices for lanes 4-7.
+ * @param state_low_x4 Receives the 64-bit states for lanes 0-3.
+ * @param state_high_x4 Receives the 64-bit states for lanes 4-7.
+ */
+static inline void chi32_internal_apply_cascading_hash_interleave_x8(int64_t selector,
+                                                                     __m256i index_low_x4, __m256i index_high_x4,
+                                                                     __m256i* state_low_x4, __m256i* state_high_x4) {
+    const uint64_t golden_ratio_prime_multiplier = 0x9E3779B97F4A7C55ULL;
+    const uint64_t final_step_prime_multiplier = 0x72A4EB92D796ED93ULL;
+
+    // The selector-only terms are identical across lanes and are computed once.
+    uint64_t primary_anchor_u64 = (uint64_t)selector;
+    uint64_t alternate_anchor_u64 = ((uint64_t)(~selector)) * golden_ratio_prime_multiplier;
+    uint64_t anchor_coupling_mask_u64 = primary_anchor_u64 & alternate_anchor_u64;
+
+    const __m256i primary_anchor = _mm256_set1_epi64x((int64_t)primary_anchor_u64);
+    const __m256i alternate_anchor = _mm256_set1_epi64x((int64_t)alternate_anchor_u64);
+    const __m256i inverted_coupling_mask = _mm256_set1_epi64x((int64_t)~anchor_coupling_mask_u64);
+
+    // ~index ^ mask == index ^ ~mask
+    __m256i primary_pointer_low = _mm256_add_epi64(primary_anchor, index_low_x4);
+    __m256i primary_pointer_high = _mm256_add_epi64(primary_anchor, index_high_x4);
+    __m256i alternate_pointer_low = _mm256_sub_epi64(alternate_anchor, _mm256_xor_si256(index_low_x4, inverted_coupling_mask));
+    __m256i alternate_pointer_high = _mm256_sub_epi64(alternate_anchor, _mm256_xor_si256(index_high_x4, inverted_coupling_mask));
+
+    // Split the 64-bit pointers into vectors of 32-bit low and high words (lane order 0..7).
+    const __m256i deinterleave_order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    primary_pointer_low = _mm256_permutevar8x32_epi32(primary_pointer_low, deinterleave_order);
+    primary_pointer_high = _mm256_permutevar8x32_epi32(primary_pointer_high, deinterleave_order);
+    alternate_pointer_low = _mm256_permutevar8x32_epi32(alternate_pointer_low, deinterleave_order);
+    alternate_pointer_high = _mm256_permutevar8x32_epi32(alternate_pointer_high, deinterleave_order);
+
+    __m256i primary_pointer_low_u32x8 = _mm256_permute2x128_si256(primary_pointer_low, primary_pointer_high, 0x20);
+    __m256i primary_pointer_high_u32x8 = _mm256_permute2x128_si256(primary_pointer_low, primary_pointer_high, 0x31);
+    __m256i alternate_pointer_low_u32x8 = _mm256_permute2x128_si256(alternate_pointer_low, alternate_pointer_high, 0x20);
+    __m256i alternate_pointer_high_u32x8 = _mm256_permute2x128_si256(alternate_pointer_low, alternate_pointer_high, 0x31);
+
+    // The 64-bit accumulator is tracked as separate low and high 32-bit words.
+    __m256i accumulator_low;
+    __m256i accumulator_high;
+    __m256i shifted_high;
+
+    accumulator_low = chi32_internal_update_hash_value_x8(_mm256_setzero_si256(), alternate_pointer_low_u32x8);
+    accumulator_high = _mm256_setzero_si256();
+
+    shifted_high = _mm256_or_si256(_mm256_slli_epi32(accumulator_high, 16), _mm256_srli_epi32(accumulator_low, 16));
+    accumulator_low = _mm256_xor_si256(chi32_internal_update_hash_value_x8(accumulator_low, alternate_pointer_high_u32x8),
+                                       _mm256_slli_epi32(accumulator_low, 16));
+    accumulator_high = shifted_high;
+
+    shifted_high = _mm256_or_si256(_mm256_slli_epi32(accumulator_high, 16), _mm256_srli_epi32(accumulator_low, 16));
+    accumulator_low = _mm256_xor_si256(chi32_internal_update_hash_value_x8(accumulator_low, primary_pointer_high_u32x8),
+                                       _mm256_slli_epi32(accumulator_low, 16));
+    accumulator_high = shifted_high;
+
+    // The final step also folds in (accumulator >> 48), which only touches the low word.
+    shifted_high = _mm256_or_si256(_mm256_slli_epi32(accumulator_high, 16), _mm256_srli_epi32(accumulator_low, 16));
+    accumulator_low = _mm256_xor_si256(_mm256_xor_si256(chi32_internal_update_hash_value_x8(accumulator_low, primary_pointer_low_u32x8),
+                                                        _mm256_slli_epi32(accumulator_low, 16)),
+                                       _mm256_srli_epi32(accumulator_high, 16));
+    accumulator_high = shifted_high;
+
+    // Re-join the words into 64-bit lanes, restoring the 0..3 / 4..7 lane order.
+    __m256i joined_01_45 = _mm256_unpacklo_epi32(accumulator_low, accumulator_high);
+    __m256i joined_23_67 = _mm256_unpackhi_epi32(accumulator_low, accumulator_high);
+
+    *state_low_x4 = chi32_internal_multiply_u64x4(_mm256_permute2x128_si256(joined_01_45, joined_23_67, 0x20),
+                                                  final_step_prime_multiplier);
+    *state_high_x4 = chi32_internal_multiply_u64x4(_mm256_permute2x128_si256(joined_01_45, joined_23_67, 0x31),
+                                                   final_step_prime_multiplier);
+}
+
+/**
+ * @brief Four-lane equivalent of the extraction window in chi32_derive_value_at.
+ * @param state_u64x4 Four 64-bit intermediate states.
+ * @return Four 64-bit lanes whose low 32 bits hold the derived values.
+ */
+static inline __m256i chi32_internal_extract_values_x4(__m256i state_u64x4) {
+    const __m256i offset_mask = _mm256_set1_epi64x(0x3F);
+    const __m256i rotate_width = _mm256_set1_epi64x(64);
+
+    __m256i offset = _mm256_and_si256(_mm256_xor_si256(_mm256_xor_si256(state_u64x4, _mm256_srli_epi64(state_u64x4, 29)),
+                                                       _mm256_srli_epi64(state_u64x4, 58)),
+                                      offset_mask);
+
+    return _mm256_or_si256(_mm256_sllv_epi64(state_u64x4, offset),
+                           _mm256_srlv_epi64(state_u64x4, _mm256_sub_epi64(rotate_width, offset)));
+}
+
+/**
+ * @brief Eight-lane equivalent of chi32_derive_value_at for a shared selector.
+ * @param selector Sequence selector shared by all lanes.
+ * @param index_low_x4 Indices for lanes 0-3.
+ * @param index_high_x4 Indices for lanes 4-7.
+ * @return Eight derived 32-bit values in lane order 0..7.
+ */
+static inline __m256i chi32_internal_derive_values_x8(int64_t selector, __m256i index_low_x4, __m256i index_high_x4) {
+    const __m256i gather_low_words = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+    __m256i state_low;
+    __m256i state_high;
+    chi32_internal_apply_cascading_hash_interleave_x8(selector, index_low_x4, index_high_x4, &state_low, &state_high);
+
+    __m256i values_low = _mm256_permutevar8x32_epi32(chi32_internal_extract_values_x4(state_low), gather_low_words);
+    __m256i values_high = _mm256_permutevar8x32_epi32(chi32_internal_extract_values_x4(state_high), gather_low_words);
+
+    return _mm256_permute2x128_si256(values_low, values_high, 0x20);
+}
+
+#endif // CHI32_BATCH_USE_AVX2
+
+// === Internal batch implementation (Static Inline) ===
+
+/**
+ * @brief Uninstrumented implementation of chi32_derive_values_at, shared by the companion headers.
+ * @param selector    Sequence selector.
+ * @param first_index Index of the first value to derive.
+ * @param count       Number of values to derive.
+ * @param values      Output buffer of at least 'count' elements.
+ */
+static inline void chi32_internal_derive_values_at(int64_t selector, int64_t first_index, size_t count, int32_t* values) {
+    size_t position = 0;
+    uint64_t index_u64 = (uint64_t)first_index;
+
+#if CHI32_BATCH_USE_AVX2
+    const __m256i lane_offsets_low = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i lane_offsets_high = _mm256_setr_epi64x(4, 5, 6, 7);
+    const size_t vector_count = count - count % CHI32_BATCH_LANE_COUNT;
+
+    for (; position < vector_count; position += CHI32_BATCH_LANE_COUNT) {
+        __m256i base_index = _mm256_set1_epi64x((int64_t)index_u64);
+        __m256i derived = chi32_internal_derive_values_x8(selector,
+                                                          _mm256_add_epi64(base_index, lane_offsets_low),
+                                                          _mm256_add_epi64(base_index, lane_offsets_high));
+        _mm256_storeu_si256((__m256i*)(values + position), derived);
+        index_u64 += CHI32_BATCH_LANE_COUNT;
+    }
+#endif
+
+    for (; position < count; ++position) {
+        values[position] = chi32_internal_extract_value(
+            (uint64_t)chi32_apply_cascading_hash_interleave(selector, (int64_t)index_u64));
+        index_u64++;
+    }
+}
+
+// === CHI32 batch helpers (Static Inline) ===
+
+/**
+ * @brief Calculates consecutive pseudo-random values of a sequence.
+ *
+ * Equivalent to values[i] = chi32_derive_value_at(selector, first_index + i) for
+ * every i in [0, count), with the index wrapping around on overflow.
+ *
+ * @param selector    Sequence selector.
+ * @param first_index Index of the first value to derive.
+ * @param count       Number of values to derive.
+ * @param values      Output buffer of at least 'count' elements.
+ */
+static inline void chi32_derive_values_at(int64_t selector, int64_t first_index, size_t count, int32_t* values) {
+    CHI32_METRICS_START_TIMER(metrics_timer);
+    chi32_internal_derive_values_at(selector, first_index, count, values);
+    CHI32_METRICS_RECORD_TIMED(CHI32_METRICS_API_BATCH, count, metrics_timer);
+}
+
+#endif // CHI32_BATCH_H
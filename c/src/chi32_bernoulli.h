@@ -0,0 +1,321 @@
+#ifndef CHI32_BERNOULLI_H
+#define CHI32_BERNOULLI_H
+
+// MIT License
+//
+// Copyright (c) 2025 Janusz Pelc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Bit-packed Bernoulli(p) masks derived from CHI32.
+//
+// A mask is a sequence of 32-bit words; bit b of mask word w is mask bit
+// (w * 32 + b), least significant bit first. Every bit is a pure function of
+// (selector, bit_index, probability), so any part of a mask can be regenerated
+// independently of the rest.
+//
+// Two generation modes are used, chosen when the probability is set up:
+//
+// - Dyadic (p = numerator / 2^depth): each mask word combines 'depth' derived
+//   values with AND/OR, one per binary digit of p. The result is exact and costs
+//   'depth' derivations per 32 mask bits (e.g. a single derivation for p = 1/2).
+//   Mask word w consumes indices [w * depth, (w + 1) * depth).
+//
+// - Threshold (any other p): mask bit i is set when the value derived at index i,
+//   read as unsigned, is below round(p * 2^32). This costs one derivation per bit.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "chi32.h"
+#include "chi32_batch.h"
+#include "chi32_metrics.h"
+
+// The AVX2 path reuses the intrinsics pulled in by chi32_batch.h; SSE2 is the fallback.
+#if !CHI32_BATCH_USE_AVX2 && defined(__SSE2__) && !defined(CHI32_BATCH_DISABLE_SIMD)
+#define CHI32_BERNOULLI_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Largest dyadic depth (log2 of the denominator) handled by bit-combining.
+ */
+#define CHI32_BERNOULLI_MAX_DYADIC_DEPTH 32
+
+/**
+ * @brief Number of derived values buffered per internal generation step.
+ */
+#define CHI32_BERNOULLI_BUFFER_LENGTH 256
+
+typedef enum {
+    CHI32_BERNOULLI_DYADIC = 0,
+    CHI32_BERNOULLI_THRESHOLD = 1
+} chi32_bernoulli_mode_t;
+
+/**
+ * @brief Prepared description of a Bernoulli(p) probability.
+ *
+ * Dyadic: p = numerator / 2^depth, with 'numerator' odd unless depth is 0 (p is 0 or 1).
+ * Threshold: p = numerator / 2^32, with 'numerator' in [1, 2^32 - 1] and 'depth' unused.
+ */
+typedef struct {
+    chi32_bernoulli_mode_t mode;
+    int depth;
+    uint64_t numerator;
+} chi32_bernoulli_t;
+
+// === Probability setup (Static Inline) ===
+
+/**
+ * @brief Prepares an exact dyadic probability numerator / 2^log2_denominator.
+ *
+ * The fraction is reduced so that mask generation uses the fewest derivations.
+ *
+ * @param numerator        Probability numerator (caller ensures numerator <= 2^log2_denominator).
+ * @param log2_denominator Base-2 logarithm of the denominator (caller ensures 0..32).
+ * @return The prepared probability.
+ */
+static inline chi32_bernoulli_t chi32_bernoulli_dyadic(uint64_t numerator, int log2_denominator) {
+    chi32_bernoulli_t bernoulli;
+
+    while (log2_denominator > 0 && (numerator & 1U) == 0) {
+        numerator >>= 1;
+        log2_denominator--;
+    }
+
+    bernoulli.mode = CHI32_BERNOULLI_DYADIC;
+    bernoulli.depth = log2_denominator;
+    bernoulli.numerator = numerator;
+
+    return bernoulli;
+}
+
+/**
+ * @brief Prepares an arbitrary probability.
+ *
+ * Values that are exactly k / 2^d for d <= CHI32_BERNOULLI_MAX_DYADIC_DEPTH use the
+ * exact dyadic mode; all others use the threshold mode. Values outside [0, 1] are clamped.
+ *
+ * @param probability Probability of a mask bit being set.
+ * @return The prepared probability.
+ */
+static inline chi32_bernoulli_t chi32_bernoulli_probability(double probability) {
+    if (!(probability > 0.0)) {
+        return chi32_bernoulli_dyadic(0, 0);
+    }
+    if (probability >= 1.0) {
+        return chi32_bernoulli_dyadic(1, 0);
+    }
+
+    const double scale_2_pow_32 = 4294967296.0;
+    double scaled = probability * scale_2_pow_32; // Exact: scaling by a power of two.
+    uint64_t truncated = (uint64_t)scaled;
+
+    if ((double)truncated == scaled) {
+        return chi32_bernoulli_dyadic(truncated, CHI32_BERNOULLI_MAX_DYADIC_DEPTH);
+    }
+
+    chi32_bernoulli_t bernoulli;
+    uint64_t threshold = (uint64_t)(scaled + 0.5);
+
+    if (threshold == 0) {
+        return chi32_bernoulli_dyadic(0, 0);
+    }
+    if (threshold >= (1ULL << 32)) {
+        return chi32_bernoulli_dyadic(1, 0);
+    }
+
+    bernoulli.mode = CHI32_BERNOULLI_THRESHOLD;
+    bernoulli.depth = 0;
+    bernoulli.numerator = threshold;
+
+    return bernoulli;
+}
+
+// === Internal helper functions (Static Inline) ===
+
+/**
+ * @brief Packs "value < threshold" comparisons of 32 derived values into a mask word.
+ * @param values    32 derived values; values[b] maps to bit b.
+ * @param threshold Unsigned threshold (caller ensures 1..2^32-1).
+ * @return The packed mask word.
+ */
+static inline uint32_t chi32_internal_pack_threshold_bits(const int32_t* values, uint32_t threshold) {
+    uint32_t mask_word = 0;
+
+#if CHI32_BATCH_USE_AVX2
+    // Unsigned compare via signed compare on sign-flipped operands.
+    const __m256i sign_flip = _mm256_set1_epi32((int32_t)0x80000000U);
+    const __m256i flipped_threshold = _mm256_set1_epi32((int32_t)(threshold ^ 0x80000000U));
+
+    for (int lane_group = 0; lane_group < 4; ++lane_group) {
+        __m256i flipped_values = _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(values + lane_group * 8)), sign_flip);
+        __m256i below = _mm256_cmpgt_epi32(flipped_threshold, flipped_values);
+        mask_word |= (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(below)) << (lane_group * 8);
+    }
+#elif defined(CHI32_BERNOULLI_USE_SSE2)
+    const __m128i sign_flip = _mm_set1_epi32((int32_t)0x80000000U);
+    const __m128i flipped_threshold = _mm_set1_epi32((int32_t)(threshold ^ 0x80000000U));
+
+    for (int lane_group = 0; lane_group < 8; ++lane_group) {
+        __m128i flipped_values = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(values + lane_group * 4)), sign_flip);
+        __m128i below = _mm_cmpgt_epi32(flipped_threshold, flipped_values);
+        mask_word |= (uint32_t)_mm_movemask_ps(_mm_castsi128_ps(below)) << (lane_group * 4);
+    }
+#else
+    for (int bit = 0; bit < 32; ++bit) {
+        mask_word |= (uint32_t)((uint32_t)values[bit] < threshold) << bit;
+    }
+#endif
+
+    return mask_word;
+}
+
+/**
+ * @brief Combines 'depth' derived values into a dyadic Bernoulli mask word.
+ *
+ * Digits of the numerator are consumed from least to most significant: a set digit
+ * ORs in the next value, a clear digit ANDs it in, so each bit ends up set with
+ * probability numerator / 2^depth.
+ *
+ * @param values    'depth' derived values; values[j] pairs with numerator digit j.
+ * @param numerator Dyadic numerator.
+ * @param depth     Dyadic depth (caller ensures 1..32).
+ * @return The combined mask word.
+ */
+static inline uint32_t chi32_internal_combine_dyadic_bits(const int32_t* values, uint64_t numerator, int depth) {
+    uint32_t mask_word = 0;
+
+    for (int digit = 0; digit < depth; ++digit) {
+        uint32_t value_u32 = (uint32_t)values[digit];
+        mask_word = ((numerator >> digit) & 1U) ? (mask_word | value_u32) : (mask_word & value_u32);
+    }
+
+    return mask_word;
+}
+
+/**
+ * @brief Uninstrumented implementation of chi32_derive_mask_words_at.
+ */
+static inline void chi32_internal_derive_mask_words_at(int64_t selector, int64_t first_word_index, size_t word_count,
+                                                       chi32_bernoulli_t bernoulli, uint32_t* mask_words) {
+    int32_t values[CHI32_BERNOULLI_BUFFER_LENGTH];
+    size_t position = 0;
+
+    if (bernoulli.mode == CHI32_BERNOULLI_THRESHOLD) {
+        const size_t words_per_step = CHI32_BERNOULLI_BUFFER_LENGTH / 32;
+        uint32_t threshold = (uint32_t)bernoulli.numerator;
+        uint64_t index_u64 = (uint64_t)first_word_index * 32U;
+
+        while (position < word_count) {
+            size_t step_words = word_count - position < words_per_step ? word_count - position : words_per_step;
+
+            chi32_internal_derive_values_at(selector, (int64_t)index_u64, step_words * 32, values);
+            for (size_t word = 0; word < step_words; ++word) {
+                mask_words[position + word] = chi32_internal_pack_threshold_bits(values + word * 32, threshold);
+            }
+
+            position += step_words;
+            index_u64 += (uint64_t)step_words * 32U;
+        }
+        return;
+    }
+
+    if (bernoulli.depth == 0) {
+        uint32_t constant_word = bernoulli.numerator != 0 ? 0xFFFFFFFFU : 0U;
+        for (; position < word_count; ++position) {
+            mask_words[position] = constant_word;
+        }
+        return;
+    }
+
+    const int depth = bernoulli.depth;
+    const size_t words_per_step = CHI32_BERNOULLI_BUFFER_LENGTH / (size_t)depth;
+    uint64_t index_u64 = (uint64_t)first_word_index * (uint64_t)depth;
+
+    while (position < word_count) {
+        size_t step_words = word_count - position < words_per_step ? word_count - position : words_per_step;
+
+        chi32_internal_derive_values_at(selector, (int64_t)index_u64, step_words * (size_t)depth, values);
+        for (size_t word = 0; word < step_words; ++word) {
+            mask_words[position + word] = chi32_internal_combine_dyadic_bits(values + word * (size_t)depth,
+                                                                             bernoulli.numerator, depth);
+        }
+
+        position += step_words;
+        index_u64 += (uint64_t)step_words * (uint64_t)depth;
+    }
+}
+
+// === CHI32 Bernoulli mask generation (Static Inline) ===
+
+/**
+ * @brief Generates consecutive words of a bit-packed Bernoulli mask.
+ *
+ * @param selector         Sequence selector.
+ * @param first_word_index Index of the first mask word (covering bits first_word_index * 32 onward).
+ * @param word_count       Number of mask words to generate.
+ * @param bernoulli        Prepared probability.
+ * @param mask_words       Output buffer of at least 'word_count' elements.
+ */
+static inline void chi32_derive_mask_words_at(int64_t selector, int64_t first_word_index, size_t word_count,
+                                              chi32_bernoulli_t bernoulli, uint32_t* mask_words) {
+    CHI32_METRICS_START_TIMER(metrics_timer);
+    chi32_internal_derive_mask_words_at(selector, first_word_index, word_count, bernoulli, mask_words);
+    CHI32_METRICS_RECORD_TIMED(CHI32_METRICS_API_BERNOULLI, word_count, metrics_timer);
+}
+
+/**
+ * @brief Generates a single word of a bit-packed Bernoulli mask.
+ *
+ * @param selector   Sequence selector.
+ * @param word_index Index of the mask word (covering bits word_index * 32 onward).
+ * @param bernoulli  Prepared probability.
+ * @return The mask word.
+ */
+static inline uint32_t chi32_derive_mask_word_at(int64_t selector, int64_t word_index, chi32_bernoulli_t bernoulli) {
+    uint32_t mask_word;
+    chi32_derive_mask_words_at(selector, word_index, 1, bernoulli, &mask_word);
+    return mask_word;
+}
+
+/**
+ * @brief Evaluates a single bit of a Bernoulli mask.
+ *
+ * @param selector  Sequence selector.
+ * @param bit_index Index of the mask bit.
+ * @param bernoulli Prepared probability.
+ * @return 1 if the bit is set, 0 otherwise.
+ */
+static inline int chi32_derive_mask_bit_at(int64_t selector, int64_t bit_index, chi32_bernoulli_t bernoulli) {
+    CHI32_METRICS_RECORD(CHI32_METRICS_API_BERNOULLI_BIT, 1);
+
+    if (bernoulli.mode == CHI32_BERNOULLI_THRESHOLD) {
+        uint64_t state_u64 = (uint64_t)chi32_apply_cascading_hash_interleave(selector, bit_index);
+        return (uint32_t)chi32_internal_extract_value(state_u64) < (uint32_t)bernoulli.numerator;
+    }
+
+    uint64_t bit_index_u64 = (uint64_t)bit_index;
+    uint32_t mask_word;
+    chi32_internal_derive_mask_words_at(selector, (int64_t)(bit_index_u64 >> 5), 1, bernoulli, &mask_word);
+
+    return (int)((mask_word >> (bit_index_u64 & 31U)) & 1U);
+}
+
+#endif // CHI32_BERNOULLI_H
@@ -0,0 +1,169 @@
+#ifndef CHI32_KEY_HASH_H
+#define CHI32_KEY_HASH_H
+
+// MIT License
+//
+// Copyright (c) 2025 Janusz Pelc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Batch hashing of 64-bit integer keys for hash tables and partitioners.
+//
+// The hash of a key is chi32_apply_cascading_hash_interleave(seed, key): the seed
+// takes the selector role and the key takes the index role. Hashes can therefore
+// be reproduced one key at a time with the core primitive. With AVX2 enabled,
+// eight keys are hashed per step using the kernel from chi32_batch.h.
+//
+// Partition (bucket) IDs are derived from the high 32 bits of the hash with
+// multiply-shift range reduction, which maps them uniformly onto [0, partition_count)
+// without a division.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "chi32.h"
+#include "chi32_batch.h"
+#include "chi32_metrics.h"
+
+// === Internal helper functions (Static Inline) ===
+
+/**
+ * @brief Maps a 64-bit hash onto [0, partition_count) using its high 32 bits.
+ * @param hash_u64 Hash value.
+ * @param partition_count Number of partitions.
+ * @return Partition ID.
+ */
+static inline uint32_t chi32_internal_reduce_to_partition(uint64_t hash_u64, uint32_t partition_count) {
+    return (uint32_t)(((hash_u64 >> 32) * (uint64_t)partition_count) >> 32);
+}
+
+// === CHI32 key hashing (Static Inline) ===
+
+/**
+ * @brief Hashes a single 64-bit key.
+ *
+ * @param seed Hash seed (selector).
+ * @param key  Key to hash (index).
+ * @return 64-bit hash value.
+ */
+static inline uint64_t chi32_hash_key(int64_t seed, int64_t key) {
+    CHI32_METRICS_RECORD(CHI32_METRICS_API_KEY_HASH, 1);
+    return (uint64_t)chi32_apply_cascading_hash_interleave(seed, key);
+}
+
+/**
+ * @brief Hashes an array of 64-bit keys.
+ *
+ * Equivalent to hashes[i] = chi32_hash_key(seed, keys[i]) for every i in [0, count).
+ *
+ * @param seed   Hash seed (selector).
+ * @param keys   Keys to hash.
+ * @param count  Number of keys.
+ * @param hashes Output buffer of at least 'count' elements (may alias 'keys').
+ */
+static inline void chi32_hash_keys(int64_t seed, const int64_t* keys, size_t count, uint64_t* hashes) {
+    CHI32_METRICS_START_TIMER(metrics_timer);
+    size_t position = 0;
+
+#if CHI32_BATCH_USE_AVX2
+    const size_t vector_count = count - count % CHI32_BATCH_LANE_COUNT;
+
+    for (; position < vector_count; position += CHI32_BATCH_LANE_COUNT) {
+        __m256i state_low;
+        __m256i state_high;
+        chi32_internal_apply_cascading_hash_interleave_x8(seed,
+                                                          _mm256_loadu_si256((const __m256i*)(keys + position)),
+                                                          _mm256_loadu_si256((const __m256i*)(keys + position + 4)),
+                                                          &state_low, &state_high);
+        _mm256_storeu_si256((__m256i*)(hashes + position), state_low);
+        _mm256_storeu_si256((__m256i*)(hashes + position + 4), state_high);
+    }
+#endif
+
+    for (; position < count; ++position) {
+        hashes[position] = (uint64_t)chi32_apply_cascading_hash_interleave(seed, keys[position]);
+    }
+
+    CHI32_METRICS_RECORD_TIMED(CHI32_METRICS_API_KEY_HASH, count, metrics_timer);
+}
+
+/**
+ * @brief Computes the partition ID of a single 64-bit key.
+ *
+ * @param seed            Hash seed (selector).
+ * @param key             Key to hash (index).
+ * @param partition_count Number of partitions (caller ensures > 0).
+ * @return Partition ID in [0, partition_count).
+ */
+static inline uint32_t chi32_partition_key(int64_t seed, int64_t key, uint32_t partition_count) {
+    CHI32_METRICS_RECORD(CHI32_METRICS_API_KEY_HASH, 1);
+    return chi32_internal_reduce_to_partition((uint64_t)chi32_apply_cascading_hash_interleave(seed, key),
+                                              partition_count);
+}
+
+/**
+ * @brief Computes partition (bucket) IDs for an array of 64-bit keys.
+ *
+ * Equivalent to partition_ids[i] = chi32_partition_key(seed, keys[i], partition_count)
+ * for every i in [0, count).
+ *
+ * @param seed            Hash seed (selector).
+ * @param keys            Keys to hash.
+ * @param count           Number of keys.
+ * @param partition_count Number of partitions (caller ensures > 0).
+ * @param partition_ids   Output buffer of at least 'count' elements.
+ */
+static inline void chi32_partition_keys(int64_t seed, const int64_t* keys, size_t count,
+                                        uint32_t partition_count, uint32_t* partition_ids) {
+    CHI32_METRICS_START_TIMER(metrics_timer);
+    size_t position = 0;
+
+#if CHI32_BATCH_USE_AVX2
+    const size_t vector_count = count - count % CHI32_BATCH_LANE_COUNT;
+    const __m256i partition_count_x4 = _mm256_set1_epi64x((int64_t)partition_count);
+    const __m256i gather_high_words = _mm256_setr_epi32(1, 3, 5, 7, 0, 2, 4, 6);
+
+    for (; position < vector_count; position += CHI32_BATCH_LANE_COUNT) {
+        __m256i state_low;
+        __m256i state_high;
+        chi32_internal_apply_cascading_hash_interleave_x8(seed,
+                                                          _mm256_loadu_si256((const __m256i*)(keys + position)),
+                                                          _mm256_loadu_si256((const __m256i*)(keys + position + 4)),
+                                                          &state_low, &state_high);
+
+        // (hash >> 32) * partition_count; the partition ID is the high word of each 64-bit product.
+        __m256i product_low = _mm256_mul_epu32(_mm256_srli_epi64(state_low, 32), partition_count_x4);
+        __m256i product_high = _mm256_mul_epu32(_mm256_srli_epi64(state_high, 32), partition_count_x4);
+
+        __m256i ids_low = _mm256_permutevar8x32_epi32(product_low, gather_high_words);
+        __m256i ids_high = _mm256_permutevar8x32_epi32(product_high, gather_high_words);
+
+        _mm256_storeu_si256((__m256i*)(partition_ids + position), _mm256_permute2x128_si256(ids_low, ids_high, 0x20));
+    }
+#endif
+
+    for (; position < count; ++position) {
+        partition_ids[position] = chi32_internal_reduce_to_partition(
+            (uint64_t)chi32_apply_cascading_hash_interleave(seed, keys[position]), partition_count);
+    }
+
+    CHI32_METRICS_RECORD_TIMED(CHI32_METRICS_API_KEY_HASH, count, metrics_timer);
+}
+
+#endif // CHI32_KEY_HASH_H
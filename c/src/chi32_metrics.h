@@ -0,0 +1,326 @@
+#ifndef CHI32_METRICS_H
+#define CHI32_METRICS_H
+
+// MIT License
+//
+// Copyright (c) 2025 Janusz Pelc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Opt-in usage and throughput instrumentation for CHI32.
+//
+// Instrumentation is compiled in only when CHI32_ENABLE_METRICS is defined for
+// every translation unit (e.g. -DCHI32_ENABLE_METRICS). Otherwise this header
+// only defines empty macros and the generators contain no instrumentation code.
+//
+// When enabled, each public generation entry point records, per calling thread:
+// the number of calls, the number of values produced (values, mask words or bits, hashes)
+// and a histogram of per-call counts in power-of-two buckets. Defining
+// CHI32_METRICS_ENABLE_TIMING additionally accumulates rdtsc cycles spent in
+// batch refills (x86 only; elsewhere cycles stay zero).
+//
+// Counters live in one heap block per thread, aligned and padded to a cache line,
+// and are only written by their owning thread. Blocks are linked into a lock-free
+// registry that chi32_metrics_take_snapshot() walks with relaxed atomic loads.
+// Blocks are never freed, so counts from finished threads remain in the totals.
+// Each block costs about 1.8 KB. A thread that exits without releasing its block
+// keeps that memory for the life of the process. Worker threads should therefore
+// call chi32_metrics_release_thread() before they exit. The next thread that
+// records reuses the released block, and its counts are kept. With releases, the
+// registry grows to the peak number of concurrently recording threads, not the
+// total number of threads ever created.
+// Counters are never reset; compare two snapshots to measure an interval.
+//
+// Requires GCC or Clang (thread-local storage, __atomic builtins, weak symbols).
+
+#include <stdint.h>
+
+#if defined(CHI32_ENABLE_METRICS)
+
+#if !defined(__GNUC__)
+#error "CHI32_ENABLE_METRICS requires GCC or Clang."
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(CHI32_METRICS_ENABLE_TIMING) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CHI32_METRICS_HAS_CYCLE_COUNTER 1
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size used to align and pad per-thread counter blocks.
+ */
+#define CHI32_METRICS_CACHE_LINE_SIZE 64
+
+/**
+ * @brief Number of batch-size buckets: bucket 0 holds empty calls, bucket k holds counts in [2^(k-1), 2^k).
+ */
+#define CHI32_METRICS_BATCH_SIZE_BUCKETS 33
+
+typedef enum {
+    CHI32_METRICS_API_SCALAR = 0,        // chi32_derive_value_at
+    CHI32_METRICS_API_BATCH = 1,         // chi32_derive_values_at
+    CHI32_METRICS_API_BERNOULLI = 2,     // chi32_derive_mask_words_at / _word_at (counts mask words)
+    CHI32_METRICS_API_KEY_HASH = 3,      // chi32_key_hash.h (counts keys)
+    CHI32_METRICS_API_VIEW = 4,          // chi32_view.hpp iterators (counts values computed)
+    CHI32_METRICS_API_BERNOULLI_BIT = 5, // chi32_derive_mask_bit_at (counts mask bits)
+    CHI32_METRICS_API_COUNT = 6
+} chi32_metrics_api_t;
+
+typedef struct {
+    uint64_t calls;
+    uint64_t values;
+    uint64_t cycles;
+    uint64_t batch_size_histogram[CHI32_METRICS_BATCH_SIZE_BUCKETS];
+} chi32_metrics_counters_t;
+
+typedef struct chi32_metrics_thread_block {
+    chi32_metrics_counters_t counters[CHI32_METRICS_API_COUNT];
+    struct chi32_metrics_thread_block* next; // Immutable once the block is registered.
+    int owned;                               // 1 while a thread records into the block.
+} chi32_metrics_thread_block_t;
+
+typedef struct {
+    chi32_metrics_counters_t counters[CHI32_METRICS_API_COUNT];
+    uint64_t block_count; // Registered blocks: the peak number of concurrently recording threads.
+} chi32_metrics_snapshot_t;
+
+// Shared across translation units through weak definitions, so no separate
+// implementation file is needed.
+__attribute__((weak)) chi32_metrics_thread_block_t* chi32_metrics_registry_head = NULL;
+__attribute__((weak)) __thread chi32_metrics_thread_block_t* chi32_metrics_current_thread_block = NULL;
+
+// === Internal helper functions (Static Inline) ===
+
+/**
+ * @brief Claims a released counter block, or allocates and registers a new one.
+ * @return The calling thread's block, or a shared unregistered block if allocation fails.
+ */
+static inline chi32_metrics_thread_block_t* chi32_internal_metrics_register_thread(void) {
+    static chi32_metrics_thread_block_t fallback_block;
+    const size_t line = CHI32_METRICS_CACHE_LINE_SIZE;
+    const size_t padded_size = (sizeof(chi32_metrics_thread_block_t) + line - 1) / line * line;
+
+    // The registry only grows, so a scan plus a CAS on the owner flag is ABA-free.
+    // Acquiring the flag makes the previous owner's counter updates visible.
+    for (chi32_metrics_thread_block_t* block = __atomic_load_n(&chi32_metrics_registry_head, __ATOMIC_ACQUIRE);
+         block != NULL; block = block->next) {
+        int expected_owned = 0;
+        if (__atomic_load_n(&block->owned, __ATOMIC_RELAXED) == 0 &&
+            __atomic_compare_exchange_n(&block->owned, &expected_owned, 1, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            chi32_metrics_current_thread_block = block;
+            return block;
+        }
+    }
+
+    unsigned char* raw = (unsigned char*)calloc(1, padded_size + line);
+    if (raw == NULL) {
+        return &fallback_block; // Counts are dropped rather than failing the generator.
+    }
+
+    chi32_metrics_thread_block_t* block =
+        (chi32_metrics_thread_block_t*)(raw + (line - (uintptr_t)raw % line));
+    block->owned = 1;
+
+    chi32_metrics_thread_block_t* head = __atomic_load_n(&chi32_metrics_registry_head, __ATOMIC_RELAXED);
+    do {
+        block->next = head;
+    } while (!__atomic_compare_exchange_n(&chi32_metrics_registry_head, &head, block, 1,
+                                          __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+
+    chi32_metrics_current_thread_block = block;
+    return block;
+}
+
+/**
+ * @brief Adds to a counter owned by the calling thread (readable concurrently by snapshots).
+ */
+static inline void chi32_internal_metrics_add(uint64_t* counter, uint64_t amount) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + amount, __ATOMIC_RELAXED);
+}
+
+// === CHI32 metrics recording (Static Inline) ===
+
+/**
+ * @brief Reads the cycle counter used for refill timing.
+ * @return Current timestamp counter, or 0 when timing is not enabled or not supported.
+ */
+static inline uint64_t chi32_metrics_read_cycles(void) {
+#if defined(CHI32_METRICS_HAS_CYCLE_COUNTER)
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Records one call of a generation API on the calling thread.
+ * @param api         API that was called.
+ * @param value_count Number of values (words, hashes) produced by the call.
+ * @param cycles      Cycles spent in the call, or 0 if not timed.
+ */
+static inline void chi32_metrics_record(chi32_metrics_api_t api, uint64_t value_count, uint64_t cycles) {
+    chi32_metrics_thread_block_t* block = chi32_metrics_current_thread_block;
+    if (__builtin_expect(block == NULL, 0)) {
+        block = chi32_internal_metrics_register_thread();
+    }
+
+    chi32_metrics_counters_t* counters = &block->counters[api];
+    int bucket = value_count == 0 ? 0 : 64 - __builtin_clzll(value_count);
+    if (bucket >= CHI32_METRICS_BATCH_SIZE_BUCKETS) {
+        bucket = CHI32_METRICS_BATCH_SIZE_BUCKETS - 1;
+    }
+
+    chi32_internal_metrics_add(&counters->calls, 1);
+    chi32_internal_metrics_add(&counters->values, value_count);
+    chi32_internal_metrics_add(&counters->cycles, cycles);
+    chi32_internal_metrics_add(&counters->batch_size_histogram[bucket], 1);
+}
+
+/**
+ * @brief Returns the calling thread's counter block for reuse by later threads.
+ *
+ * Call before a recording thread exits, e.g. at the end of a pool worker. Counts
+ * already recorded stay in the totals. Recording again afterwards claims a block anew.
+ */
+static inline void chi32_metrics_release_thread(void) {
+    chi32_metrics_thread_block_t* block = chi32_metrics_current_thread_block;
+    if (block == NULL) {
+        return;
+    }
+
+    chi32_metrics_current_thread_block = NULL;
+    __atomic_store_n(&block->owned, 0, __ATOMIC_RELEASE);
+}
+
+// === CHI32 metrics export (Static Inline) ===
+
+/**
+ * @brief Returns a short, stable name for an API, suitable for export.
+ */
+static inline const char* chi32_metrics_api_name(chi32_metrics_api_t api) {
+    switch (api) {
+        case CHI32_METRICS_API_SCALAR:    return "scalar";
+        case CHI32_METRICS_API_BATCH:     return "batch";
+        case CHI32_METRICS_API_BERNOULLI: return "bernoulli";
+        case CHI32_METRICS_API_BERNOULLI_BIT: return "bernoulli_bit";
+        case CHI32_METRICS_API_KEY_HASH:  return "key_hash";
+        case CHI32_METRICS_API_VIEW:      return "view";
+        default:                          return "unknown";
+    }
+}
+
+/**
+ * @brief Aggregates the counters of all threads without taking locks.
+ *
+ * Counters of threads that are still generating may be a few updates behind.
+ *
+ * @param snapshot Receives the totals.
+ */
+static inline void chi32_metrics_take_snapshot(chi32_metrics_snapshot_t* snapshot) {
+    const size_t words_per_api = sizeof(chi32_metrics_counters_t) / sizeof(uint64_t);
+
+    for (int api = 0; api < CHI32_METRICS_API_COUNT; ++api) {
+        uint64_t* totals = &snapshot->counters[api].calls;
+        for (size_t word = 0; word < words_per_api; ++word) {
+            totals[word] = 0;
+        }
+    }
+    snapshot->block_count = 0;
+
+    for (chi32_metrics_thread_block_t* block = __atomic_load_n(&chi32_metrics_registry_head, __ATOMIC_ACQUIRE);
+         block != NULL; block = block->next) {
+        for (int api = 0; api < CHI32_METRICS_API_COUNT; ++api) {
+            uint64_t* totals = &snapshot->counters[api].calls;
+            uint64_t* counters = &block->counters[api].calls;
+            for (size_t word = 0; word < words_per_api; ++word) {
+                totals[word] += __atomic_load_n(&counters[word], __ATOMIC_RELAXED);
+            }
+        }
+        snapshot->block_count++;
+    }
+}
+
+/**
+ * @brief Writes a snapshot as CSV: one row per API and non-empty batch-size bucket.
+ *
+ * Columns: api,calls,values,cycles,bucket_min,bucket_max,bucket_calls. The first row
+ * of each API has empty bucket columns and carries the API totals.
+ *
+ * @param stream   Output stream.
+ * @param snapshot Snapshot to write.
+ */
+static inline void chi32_metrics_write_csv(FILE* stream, const chi32_metrics_snapshot_t* snapshot) {
+    fprintf(stream, "api,calls,values,cycles,bucket_min,bucket_max,bucket_calls\n");
+
+    for (int api = 0; api < CHI32_METRICS_API_COUNT; ++api) {
+        const chi32_metrics_counters_t* counters = &snapshot->counters[api];
+        const char* name = chi32_metrics_api_name((chi32_metrics_api_t)api);
+
+        fprintf(stream, "%s,%llu,%llu,%llu,,,\n", name, (unsigned long long)counters->calls,
+                (unsigned long long)counters->values, (unsigned long long)counters->cycles);
+
+        for (int bucket = 0; bucket < CHI32_METRICS_BATCH_SIZE_BUCKETS; ++bucket) {
+            if (counters->batch_size_histogram[bucket] == 0) continue;
+            unsigned long long bucket_min = bucket == 0 ? 0ULL : 1ULL << (bucket - 1);
+            unsigned long long bucket_max = bucket == 0 ? 0ULL : (1ULL << bucket) - 1;
+            if (bucket == CHI32_METRICS_BATCH_SIZE_BUCKETS - 1) {
+                bucket_max = ~0ULL;
+            }
+            fprintf(stream, "%s,,,,%llu,%llu,%llu\n", name, bucket_min, bucket_max,
+                    (unsigned long long)counters->batch_size_histogram[bucket]);
+        }
+    }
+}
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+/**
+ * @brief Starts timing a refill; pair with CHI32_METRICS_RECORD_TIMED.
+ */
+#define CHI32_METRICS_START_TIMER(timer) uint64_t timer = chi32_metrics_read_cycles()
+
+/**
+ * @brief Records a timed call started with CHI32_METRICS_START_TIMER.
+ */
+#define CHI32_METRICS_RECORD_TIMED(api, value_count, timer) \
+    chi32_metrics_record((api), (uint64_t)(value_count), chi32_metrics_read_cycles() - (timer))
+
+/**
+ * @brief Records an untimed call.
+ */
+#define CHI32_METRICS_RECORD(api, value_count) chi32_metrics_record((api), (uint64_t)(value_count), 0)
+
+#else // CHI32_ENABLE_METRICS
+
+#define CHI32_METRICS_START_TIMER(timer) ((void)0)
+#define CHI32_METRICS_RECORD_TIMED(api, value_count, timer) ((void)0)
+#define CHI32_METRICS_RECORD(api, value_count) ((void)0)
+
+#endif // CHI32_ENABLE_METRICS
+
+#endif // CHI32_METRICS_H
@@ -0,0 +1,294 @@
+#ifndef CHI32_VIEW_HPP
+#define CHI32_VIEW_HPP
+
+// MIT License
+//
+// Copyright (c) 2025 Janusz Pelc
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Lazy, zero-storage C++ range over a CHI32 sequence (requires C++17; C++20 adds
+// std::ranges integration).
+//
+// chi32::view(selector, first, last) behaves like a read-only random-access
+// container holding chi32_derive_value_at(selector, i) for i in [first, last),
+// but no values are stored: iterators compute them on demand.
+//
+// Each iterator carries a small block of precomputed values. Stepping with ++ or --
+// refills that block with chi32_derive_values_at (vectorized when available), so
+// sequential traversal in either direction runs at batch speed. Jumps (+=, -=, [])
+// and dereferences outside the block compute single values with the scalar primitive.
+// Dereferencing never modifies an iterator, so const iterators can be shared freely
+// between threads, e.g. by parallel std::execution algorithms.
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#if __cplusplus >= 202002L
+#include <ranges>
+#endif
+
+#include "chi32.h"
+#include "chi32_batch.h"
+#include "chi32_metrics.h"
+
+namespace chi32 {
+
+/**
+ * @brief Random-access iterator over a lazily computed CHI32 sequence.
+ *
+ * Dereferencing yields values (not references), like the iterators of std::views::iota.
+ */
+class value_iterator {
+public:
+    using value_type = std::int32_t;
+    using difference_type = std::int64_t;
+    using reference = std::int32_t;
+    using pointer = void;
+    using iterator_category = std::random_access_iterator_tag;
+#if __cplusplus >= 202002L
+    using iterator_concept = std::random_access_iterator_tag;
+#endif
+
+    /**
+     * @brief Number of values precomputed per refill during sequential traversal.
+     */
+    static constexpr difference_type block_length = 2 * CHI32_BATCH_LANE_COUNT;
+
+    value_iterator() = default;
+
+    /**
+     * @brief Creates an iterator at 'index' within the range [first, last).
+     *
+     * The bounds only limit how far ahead (or behind) blocks are precomputed.
+     *
+     * @param selector Sequence selector.
+     * @param index    Current position.
+     * @param first    First index of the enclosing range.
+     * @param last     One past the last index of the enclosing range.
+     */
+    value_iterator(std::int64_t selector, std::int64_t index, std::int64_t first, std::int64_t last) noexcept
+        : selector_(selector), index_(index), first_(first), last_(last) {}
+
+    /**
+     * @brief Returns the index the iterator currently points at.
+     */
+    std::int64_t index() const noexcept { return index_; }
+
+    reference operator*() const noexcept {
+        if (block_contains(index_)) {
+            return block_[index_ - block_first_];
+        }
+        return derive_single(selector_, index_);
+    }
+
+    reference operator[](difference_type n) const noexcept {
+        return derive_single(selector_, offset_index(index_, n));
+    }
+
+    value_iterator& operator++() noexcept {
+        ++index_;
+        if (!block_contains(index_)) {
+            refill_forward();
+        }
+        return *this;
+    }
+
+    value_iterator operator++(int) noexcept {
+        value_iterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    value_iterator& operator--() noexcept {
+        --index_;
+        if (!block_contains(index_)) {
+            refill_backward();
+        }
+        return *this;
+    }
+
+    value_iterator operator--(int) noexcept {
+        value_iterator previous = *this;
+        --*this;
+        return previous;
+    }
+
+    value_iterator& operator+=(difference_type n) noexcept {
+        index_ = offset_index(index_, n);
+        return *this;
+    }
+
+    value_iterator& operator-=(difference_type n) noexcept {
+        index_ = offset_index(index_, static_cast<difference_type>(0 - static_cast<std::uint64_t>(n)));
+        return *this;
+    }
+
+    friend value_iterator operator+(value_iterator it, difference_type n) noexcept { return it += n; }
+    friend value_iterator operator+(difference_type n, value_iterator it) noexcept { return it += n; }
+    friend value_iterator operator-(value_iterator it, difference_type n) noexcept { return it -= n; }
+
+    // Distances above INT64_MAX (only possible in ranges longer than that) wrap instead of overflowing.
+    friend difference_type operator-(const value_iterator& a, const value_iterator& b) noexcept {
+        return static_cast<difference_type>(static_cast<std::uint64_t>(a.index_) - static_cast<std::uint64_t>(b.index_));
+    }
+
+    friend bool operator==(const value_iterator& a, const value_iterator& b) noexcept { return a.index_ == b.index_; }
+    friend bool operator!=(const value_iterator& a, const value_iterator& b) noexcept { return a.index_ != b.index_; }
+    friend bool operator<(const value_iterator& a, const value_iterator& b) noexcept { return a.index_ < b.index_; }
+    friend bool operator>(const value_iterator& a, const value_iterator& b) noexcept { return a.index_ > b.index_; }
+    friend bool operator<=(const value_iterator& a, const value_iterator& b) noexcept { return a.index_ <= b.index_; }
+    friend bool operator>=(const value_iterator& a, const value_iterator& b) noexcept { return a.index_ >= b.index_; }
+
+    /**
+     * @brief Computes one value outside the block, recorded as view usage when metrics are enabled.
+     */
+    static std::int32_t derive_single(std::int64_t selector, std::int64_t index) noexcept {
+        CHI32_METRICS_RECORD(CHI32_METRICS_API_VIEW, 1);
+        return chi32_internal_extract_value(
+            static_cast<std::uint64_t>(chi32_apply_cascading_hash_interleave(selector, index)));
+    }
+
+private:
+    // Index arithmetic wraps in uint64_t, like chi32_derive_values_at, so it cannot overflow.
+    static std::int64_t offset_index(std::int64_t index, difference_type n) noexcept {
+        return static_cast<std::int64_t>(static_cast<std::uint64_t>(index) + static_cast<std::uint64_t>(n));
+    }
+
+    bool block_contains(std::int64_t index) const noexcept {
+        // One unsigned compare covers both bounds and cannot overflow.
+        return static_cast<std::uint64_t>(index) - static_cast<std::uint64_t>(block_first_) <
+               static_cast<std::uint64_t>(block_size_);
+    }
+
+    // Offsets are unsigned: a valid range may be longer than INT64_MAX (e.g. [INT64_MIN, 1)).
+    std::uint64_t offset_from_first(std::int64_t index) const noexcept {
+        return static_cast<std::uint64_t>(index) - static_cast<std::uint64_t>(first_);
+    }
+
+    std::uint64_t range_length() const noexcept { return offset_from_first(last_); }
+
+    // Precomputes [index_, index_ + block_length), clipped to the range end.
+    void refill_forward() noexcept {
+        const std::uint64_t offset = offset_from_first(index_);
+        const std::uint64_t remaining = offset < range_length() ? range_length() - offset : 0;
+        block_first_ = index_;
+        block_size_ = remaining < static_cast<std::uint64_t>(block_length) ? static_cast<difference_type>(remaining)
+                                                                           : block_length;
+        if (block_size_ > 0) {
+            fill_block();
+        }
+    }
+
+    // Precomputes (index_ - block_length, index_], clipped to the range start.
+    void refill_backward() noexcept {
+        const std::uint64_t offset = offset_from_first(index_);
+        const std::uint64_t available = offset < range_length() ? offset + 1 : 0;
+        block_size_ = available < static_cast<std::uint64_t>(block_length) ? static_cast<difference_type>(available)
+                                                                           : block_length;
+        block_first_ = static_cast<std::int64_t>(static_cast<std::uint64_t>(index_) - static_cast<std::uint64_t>(block_size_) + 1);
+        if (block_size_ > 0) {
+            fill_block();
+        }
+    }
+
+    void fill_block() noexcept {
+        CHI32_METRICS_START_TIMER(metrics_timer);
+        chi32_internal_derive_values_at(selector_, block_first_, static_cast<std::size_t>(block_size_), block_);
+        CHI32_METRICS_RECORD_TIMED(CHI32_METRICS_API_VIEW, block_size_, metrics_timer);
+    }
+
+    std::int64_t selector_ = 0;
+    std::int64_t index_ = 0;
+    std::int64_t first_ = 0;
+    std::int64_t last_ = 0;
+    std::int64_t block_first_ = 0;
+    difference_type block_size_ = 0;
+    std::int32_t block_[block_length] = {};
+};
+
+/**
+ * @brief Read-only, zero-storage random-access range of CHI32 values.
+ */
+class value_view
+#if __cplusplus >= 202002L
+    : public std::ranges::view_interface<value_view>
+#endif
+{
+public:
+    using value_type = std::int32_t;
+    using size_type = std::size_t;
+    using difference_type = std::int64_t;
+    using iterator = value_iterator;
+    using const_iterator = value_iterator;
+
+    value_view() = default;
+
+    /**
+     * @brief Creates a view of chi32_derive_value_at(selector, i) for i in [first, last).
+     * @param selector Sequence selector.
+     * @param first    First index (inclusive).
+     * @param last     Last index (exclusive); caller ensures first <= last.
+     *
+     * The range may be longer than INT64_MAX (e.g. [INT64_MIN, 1)); size() reports the
+     * full length, but iterator differences beyond INT64_MAX are not representable.
+     */
+    value_view(std::int64_t selector, std::int64_t first, std::int64_t last) noexcept
+        : selector_(selector), first_(first), last_(last) {}
+
+    std::int64_t selector() const noexcept { return selector_; }
+    std::int64_t first_index() const noexcept { return first_; }
+    std::int64_t last_index() const noexcept { return last_; }
+
+    value_iterator begin() const noexcept { return value_iterator(selector_, first_, first_, last_); }
+    value_iterator end() const noexcept { return value_iterator(selector_, last_, first_, last_); }
+
+    size_type size() const noexcept {
+        return static_cast<size_type>(static_cast<std::uint64_t>(last_) - static_cast<std::uint64_t>(first_));
+    }
+    bool empty() const noexcept { return first_ == last_; }
+
+    value_type operator[](size_type n) const noexcept {
+        return value_iterator::derive_single(
+            selector_, static_cast<std::int64_t>(static_cast<std::uint64_t>(first_) + static_cast<std::uint64_t>(n)));
+    }
+
+private:
+    std::int64_t selector_ = 0;
+    std::int64_t first_ = 0;
+    std::int64_t last_ = 0;
+};
+
+/**
+ * @brief Returns a lazy view of chi32_derive_value_at(selector, i) for i in [first, last).
+ */
+inline value_view view(std::int64_t selector, std::int64_t first, std::int64_t last) noexcept {
+    return value_view(selector, first, last);
+}
+
+} // namespace chi32
+
+#if __cplusplus >= 202002L
+// Iterators do not refer back to the view, so they remain valid after it is destroyed.
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<chi32::value_view> = true;
+#endif
+
+#endif // CHI32_VIEW_HPP
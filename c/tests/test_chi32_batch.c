@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../src/chi32.h"
+#include "../src/chi32_batch.h"
+
+// --- Constants ---
+
+#define MAX_BATCH_LENGTH 1000
+#define MAX_ERRORS_TO_PRINT 5
+
+// --- Type Definitions ---
+
+typedef struct {
+    const char* logical_name;
+    int64_t selector;
+    int64_t first_index;
+    size_t count;
+} batch_test_case_t;
+
+// --- Forward Declarations of Helper Functions ---
+
+bool run_test_derive_values_at(const batch_test_case_t* test_case);
+
+
+// --- Main Function ---
+
+int main(void) {
+    printf("CHI32 C Implementation - Batch Helper Tests\n");
+    printf("=================================================\n");
+    printf("Vectorized kernel: %s\n", CHI32_BATCH_USE_AVX2 ? "AVX2" : "none (scalar)");
+
+    const batch_test_case_t test_cases[] = {
+        { "empty",                    0x6A09E667F3BCC908LL, 0,                    0 },
+        { "shorter_than_lane_count",  0x6A09E667F3BCC908LL, 0,                    5 },
+        { "exact_lane_multiple",      0x0LL,                0,                    64 },
+        { "unaligned_tail",           (int64_t)0xFEDCBA9876543210ULL, 12345,      MAX_BATCH_LENGTH },
+        { "index_wraps_around",       (int64_t)0x9E3779B97F4A7C55ULL, INT64_MAX - 20, 67 },
+        { "negative_indices",         (int64_t)0xFFFFFFFFFFFFFFFFULL, -500,       MAX_BATCH_LENGTH },
+    };
+    const int num_test_cases = (int)(sizeof(test_cases) / sizeof(test_cases[0]));
+
+    bool all_overall_tests_passed = true;
+
+    for (int i = 0; i < num_test_cases; ++i) {
+        printf("\n--- Processing Test Case: %s ---\n", test_cases[i].logical_name);
+
+        if (run_test_derive_values_at(&test_cases[i])) {
+            printf("  PASS: Test case '%s' verified.\n", test_cases[i].logical_name);
+        } else {
+            fprintf(stderr, "  FAIL: Test case '%s' failed.\n", test_cases[i].logical_name);
+            all_overall_tests_passed = false;
+        }
+    }
+
+    printf("\n=================================================\n");
+    if (all_overall_tests_passed) {
+        printf("All CHI32 batch tests PASSED.\n");
+        return EXIT_SUCCESS;
+    } else {
+        printf("One or more CHI32 batch tests FAILED.\n");
+        return EXIT_FAILURE;
+    }
+}
+
+
+// --- Implementations of Helper Functions ---
+
+bool run_test_derive_values_at(const batch_test_case_t* test_case) {
+    int32_t values[MAX_BATCH_LENGTH + 1];
+    const int32_t guard_value = 0x5A5A5A5A;
+
+    printf("  Running Batch Test: Selector=0x%016llX, First Index=0x%016llX, Count=%zu\n",
+           (long long)test_case->selector, (long long)test_case->first_index, test_case->count);
+
+    values[test_case->count] = guard_value;
+    chi32_derive_values_at(test_case->selector, test_case->first_index, test_case->count, values);
+
+    int32_t errors_found = 0;
+    uint64_t index_u64 = (uint64_t)test_case->first_index;
+
+    for (size_t i = 0; i < test_case->count; ++i) {
+        uint32_t expected_value_u32 = (uint32_t)chi32_derive_value_at(test_case->selector, (int64_t)index_u64);
+        uint32_t actual_value_u32 = (uint32_t)values[i];
+
+        if (actual_value_u32 != expected_value_u32) {
+            if (errors_found < MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    MISMATCH (Batch) at position %zu (Index: 0x%016llX):\n", i, (long long)index_u64);
+                fprintf(stderr, "      Expected: 0x%08X (%u)\n", expected_value_u32, expected_value_u32);
+                fprintf(stderr, "      Actual:   0x%08X (%u)\n", actual_value_u32, actual_value_u32);
+            } else if (errors_found == MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    (Further batch mismatches suppressed...)\n");
+            }
+            errors_found++;
+        }
+        index_u64++;
+    }
+
+    if (values[test_case->count] != guard_value) {
+        fprintf(stderr, "    OVERRUN (Batch): value written past the requested count.\n");
+        errors_found++;
+    }
+
+    if (errors_found > 0) {
+        fprintf(stderr, "  Batch Test FAILED with %d mismatche(s).\n", errors_found);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include "../src/chi32.h"
+#include "../src/chi32_bernoulli.h"
+
+// --- Constants ---
+
+#define MAX_MASK_WORDS 4096
+#define MAX_ERRORS_TO_PRINT 5
+
+// Statistical checks use fixed selectors, so they are deterministic; the
+// tolerance only guards against a systematically wrong probability.
+#define FREQUENCY_TOLERANCE_SIGMAS 6.0
+
+// --- Type Definitions ---
+
+typedef struct {
+    const char* logical_name;
+    chi32_bernoulli_t bernoulli;
+    double expected_probability;
+    chi32_bernoulli_mode_t expected_mode;
+} bernoulli_test_case_t;
+
+// --- Forward Declarations of Helper Functions ---
+
+uint32_t reference_mask_word(int64_t selector, int64_t word_index, chi32_bernoulli_t bernoulli);
+bool run_test_matches_reference(const bernoulli_test_case_t* test_case, int64_t selector, int64_t first_word_index);
+bool run_test_bit_addressing(const bernoulli_test_case_t* test_case, int64_t selector);
+bool run_test_frequency(const bernoulli_test_case_t* test_case, int64_t selector);
+
+
+// --- Main Function ---
+
+int main(void) {
+    printf("CHI32 C Implementation - Bernoulli Mask Tests\n");
+    printf("=================================================\n");
+
+    const bernoulli_test_case_t test_cases[] = {
+        { "never",             chi32_bernoulli_probability(0.0),        0.0,        CHI32_BERNOULLI_DYADIC },
+        { "always",            chi32_bernoulli_probability(1.0),        1.0,        CHI32_BERNOULLI_DYADIC },
+        { "half",              chi32_bernoulli_probability(0.5),        0.5,        CHI32_BERNOULLI_DYADIC },
+        { "three_eighths",     chi32_bernoulli_dyadic(6, 4),            0.375,      CHI32_BERNOULLI_DYADIC },
+        { "dropout_one_tenth", chi32_bernoulli_probability(0.1),        0.1,        CHI32_BERNOULLI_THRESHOLD },
+        { "fine_dyadic",       chi32_bernoulli_dyadic(0x9E3779B9U, 32), 0x9E3779B9U / 4294967296.0, CHI32_BERNOULLI_DYADIC },
+        { "one_third",         chi32_bernoulli_probability(1.0 / 3.0),  1.0 / 3.0,  CHI32_BERNOULLI_THRESHOLD },
+    };
+    const int num_test_cases = (int)(sizeof(test_cases) / sizeof(test_cases[0]));
+
+    bool all_overall_tests_passed = true;
+
+    if (chi32_bernoulli_dyadic(6, 4).depth != 3 || chi32_bernoulli_dyadic(6, 4).numerator != 3) {
+        fprintf(stderr, "  FAIL: Dyadic probability 6/16 was not reduced to 3/8.\n");
+        all_overall_tests_passed = false;
+    }
+
+    for (int i = 0; i < num_test_cases; ++i) {
+        const bernoulli_test_case_t* test_case = &test_cases[i];
+        printf("\n--- Processing Test Case: %s ---\n", test_case->logical_name);
+
+        bool current_test_passed = true;
+
+        if (test_case->bernoulli.mode != test_case->expected_mode) {
+            fprintf(stderr, "    Unexpected generation mode %d (expected %d).\n",
+                    (int)test_case->bernoulli.mode, (int)test_case->expected_mode);
+            current_test_passed = false;
+        }
+
+        current_test_passed &= run_test_matches_reference(test_case, 0x6A09E667F3BCC908LL, 0);
+        current_test_passed &= run_test_matches_reference(test_case, (int64_t)0xFEDCBA9876543210ULL, -77);
+        current_test_passed &= run_test_bit_addressing(test_case, 0x12345LL);
+        current_test_passed &= run_test_frequency(test_case, (int64_t)0xBB67AE8584CAA73BULL);
+
+        if (current_test_passed) {
+            printf("  PASS: Test case '%s' verified.\n", test_case->logical_name);
+        } else {
+            fprintf(stderr, "  FAIL: Test case '%s' failed.\n", test_case->logical_name);
+            all_overall_tests_passed = false;
+        }
+    }
+
+    printf("\n=================================================\n");
+    if (all_overall_tests_passed) {
+        printf("All CHI32 Bernoulli mask tests PASSED.\n");
+        return EXIT_SUCCESS;
+    } else {
+        printf("One or more CHI32 Bernoulli mask tests FAILED.\n");
+        return EXIT_FAILURE;
+    }
+}
+
+
+// --- Implementations of Helper Functions ---
+
+// Straightforward per-bit restatement of the documented mask layout.
+uint32_t reference_mask_word(int64_t selector, int64_t word_index, chi32_bernoulli_t bernoulli) {
+    uint32_t mask_word = 0;
+
+    if (bernoulli.mode == CHI32_BERNOULLI_THRESHOLD) {
+        for (int bit = 0; bit < 32; ++bit) {
+            int64_t index = (int64_t)((uint64_t)word_index * 32U + (uint64_t)bit);
+            if ((uint32_t)chi32_derive_value_at(selector, index) < (uint32_t)bernoulli.numerator) {
+                mask_word |= 1U << bit;
+            }
+        }
+        return mask_word;
+    }
+
+    if (bernoulli.depth == 0) {
+        return bernoulli.numerator != 0 ? 0xFFFFFFFFU : 0U;
+    }
+
+    for (int bit = 0; bit < 32; ++bit) {
+        int is_set = 0;
+        for (int digit = 0; digit < bernoulli.depth; ++digit) {
+            int64_t index = (int64_t)((uint64_t)word_index * (uint64_t)bernoulli.depth + (uint64_t)digit);
+            int random_bit = (int)(((uint32_t)chi32_derive_value_at(selector, index) >> bit) & 1U);
+            is_set = ((bernoulli.numerator >> digit) & 1U) ? (is_set | random_bit) : (is_set & random_bit);
+        }
+        mask_word |= (uint32_t)is_set << bit;
+    }
+
+    return mask_word;
+}
+
+bool run_test_matches_reference(const bernoulli_test_case_t* test_case, int64_t selector, int64_t first_word_index) {
+    const size_t word_count = 37;
+    uint32_t mask_words[37];
+
+    printf("  Running Reference Test: Selector=0x%016llX, First Word=%lld, Words=%zu\n",
+           (long long)selector, (long long)first_word_index, word_count);
+
+    chi32_derive_mask_words_at(selector, first_word_index, word_count, test_case->bernoulli, mask_words);
+
+    int32_t errors_found = 0;
+
+    for (size_t i = 0; i < word_count; ++i) {
+        int64_t word_index = first_word_index + (int64_t)i;
+        uint32_t expected_word = reference_mask_word(selector, word_index, test_case->bernoulli);
+        uint32_t single_word = chi32_derive_mask_word_at(selector, word_index, test_case->bernoulli);
+
+        if (mask_words[i] != expected_word || single_word != expected_word) {
+            if (errors_found < MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    MISMATCH (Reference) at word %lld:\n", (long long)word_index);
+                fprintf(stderr, "      Expected: 0x%08X\n", expected_word);
+                fprintf(stderr, "      Batch:    0x%08X\n", mask_words[i]);
+                fprintf(stderr, "      Single:   0x%08X\n", single_word);
+            } else if (errors_found == MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    (Further reference mismatches suppressed...)\n");
+            }
+            errors_found++;
+        }
+    }
+
+    if (errors_found > 0) {
+        fprintf(stderr, "  Reference Test FAILED with %d mismatche(s).\n", errors_found);
+        return false;
+    }
+
+    return true;
+}
+
+bool run_test_bit_addressing(const bernoulli_test_case_t* test_case, int64_t selector) {
+    const int64_t first_bit_index = 1000;
+    const int bit_count = 200;
+    uint32_t mask_words[8];
+
+    chi32_derive_mask_words_at(selector, first_bit_index / 32, 8, test_case->bernoulli, mask_words);
+
+    int32_t errors_found = 0;
+
+    for (int i = 0; i < bit_count; ++i) {
+        int64_t bit_index = first_bit_index + i;
+        int64_t word_offset = bit_index / 32 - first_bit_index / 32;
+        int expected_bit = (int)((mask_words[word_offset] >> (bit_index % 32)) & 1U);
+        int actual_bit = chi32_derive_mask_bit_at(selector, bit_index, test_case->bernoulli);
+
+        if (actual_bit != expected_bit) {
+            if (errors_found < MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    MISMATCH (Bit Addressing) at bit %lld: expected %d, actual %d\n",
+                        (long long)bit_index, expected_bit, actual_bit);
+            }
+            errors_found++;
+        }
+    }
+
+    if (errors_found > 0) {
+        fprintf(stderr, "  Bit Addressing Test FAILED with %d mismatche(s).\n", errors_found);
+        return false;
+    }
+
+    return true;
+}
+
+bool run_test_frequency(const bernoulli_test_case_t* test_case, int64_t selector) {
+    static uint32_t mask_words[MAX_MASK_WORDS];
+
+    chi32_derive_mask_words_at(selector, 0, MAX_MASK_WORDS, test_case->bernoulli, mask_words);
+
+    uint64_t set_bits = 0;
+    for (int i = 0; i < MAX_MASK_WORDS; ++i) {
+        for (uint32_t word = mask_words[i]; word != 0; word &= word - 1) {
+            set_bits++;
+        }
+    }
+
+    const double total_bits = (double)MAX_MASK_WORDS * 32.0;
+    const double p = test_case->expected_probability;
+    double observed = (double)set_bits / total_bits;
+    double sigma = sqrt(p * (1.0 - p) / total_bits);
+
+    printf("  Running Frequency Test: Expected p=%.6f, Observed p=%.6f over %.0f bits\n", p, observed, total_bits);
+
+    bool passed = (sigma == 0.0) ? (observed == p) : (fabs(observed - p) <= FREQUENCY_TOLERANCE_SIGMAS * sigma);
+    if (!passed) {
+        fprintf(stderr, "  Frequency Test FAILED: deviation %.6f exceeds tolerance.\n", fabs(observed - p));
+    }
+
+    return passed;
+}
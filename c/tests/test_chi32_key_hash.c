@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../src/chi32.h"
+#include "../src/chi32_key_hash.h"
+
+// --- Constants ---
+
+#define KEY_COUNT 1003
+#define MAX_ERRORS_TO_PRINT 5
+
+// --- Type Definitions ---
+
+typedef struct {
+    const char* logical_name;
+    int64_t seed;
+    uint32_t partition_count;
+} key_hash_test_case_t;
+
+// --- Forward Declarations of Helper Functions ---
+
+void fill_keys(int64_t keys[], size_t count);
+bool run_test_hash_keys(const key_hash_test_case_t* test_case, const int64_t keys[]);
+bool run_test_partition_keys(const key_hash_test_case_t* test_case, const int64_t keys[]);
+
+
+// --- Main Function ---
+
+int main(void) {
+    printf("CHI32 C Implementation - Key Hash Tests\n");
+    printf("=================================================\n");
+    printf("Vectorized kernel: %s\n", CHI32_BATCH_USE_AVX2 ? "AVX2" : "none (scalar)");
+
+    const key_hash_test_case_t test_cases[] = {
+        { "single_partition",    0x0LL,                           1 },
+        { "odd_partition_count", 0x6A09E667F3BCC908LL,            7 },
+        { "power_of_two",        (int64_t)0xFEDCBA9876543210ULL,  1024 },
+        { "max_partition_count", (int64_t)0xFFFFFFFFFFFFFFFFULL,  UINT32_MAX },
+    };
+    const int num_test_cases = (int)(sizeof(test_cases) / sizeof(test_cases[0]));
+
+    static int64_t keys[KEY_COUNT];
+    fill_keys(keys, KEY_COUNT);
+
+    bool all_overall_tests_passed = true;
+
+    for (int i = 0; i < num_test_cases; ++i) {
+        printf("\n--- Processing Test Case: %s ---\n", test_cases[i].logical_name);
+
+        bool current_test_passed = run_test_hash_keys(&test_cases[i], keys);
+        current_test_passed &= run_test_partition_keys(&test_cases[i], keys);
+
+        if (current_test_passed) {
+            printf("  PASS: Test case '%s' verified.\n", test_cases[i].logical_name);
+        } else {
+            fprintf(stderr, "  FAIL: Test case '%s' failed.\n", test_cases[i].logical_name);
+            all_overall_tests_passed = false;
+        }
+    }
+
+    printf("\n=================================================\n");
+    if (all_overall_tests_passed) {
+        printf("All CHI32 key hash tests PASSED.\n");
+        return EXIT_SUCCESS;
+    } else {
+        printf("One or more CHI32 key hash tests FAILED.\n");
+        return EXIT_FAILURE;
+    }
+}
+
+
+// --- Implementations of Helper Functions ---
+
+// Mixes sequential, negative, extreme and scattered keys.
+void fill_keys(int64_t keys[], size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 4) {
+            case 0:  keys[i] = (int64_t)i; break;
+            case 1:  keys[i] = -(int64_t)i; break;
+            case 2:  keys[i] = (i & 8) ? INT64_MAX - (int64_t)i : INT64_MIN + (int64_t)i; break;
+            default: keys[i] = (int64_t)((uint64_t)i * 0x9E3779B97F4A7C55ULL); break;
+        }
+    }
+}
+
+bool run_test_hash_keys(const key_hash_test_case_t* test_case, const int64_t keys[]) {
+    static uint64_t hashes[KEY_COUNT];
+    static int64_t in_place[KEY_COUNT];
+
+    printf("  Running Hash Test: Seed=0x%016llX, Keys=%d\n", (long long)test_case->seed, KEY_COUNT);
+
+    chi32_hash_keys(test_case->seed, keys, KEY_COUNT, hashes);
+
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        in_place[i] = keys[i];
+    }
+    chi32_hash_keys(test_case->seed, in_place, KEY_COUNT, (uint64_t*)in_place);
+
+    int32_t errors_found = 0;
+
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        uint64_t expected_hash = (uint64_t)chi32_apply_cascading_hash_interleave(test_case->seed, keys[i]);
+
+        if (hashes[i] != expected_hash || (uint64_t)in_place[i] != expected_hash) {
+            if (errors_found < MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    MISMATCH (Hash) at position %zu (Key: 0x%016llX):\n", i, (long long)keys[i]);
+                fprintf(stderr, "      Expected: 0x%016llX\n", (unsigned long long)expected_hash);
+                fprintf(stderr, "      Batch:    0x%016llX\n", (unsigned long long)hashes[i]);
+                fprintf(stderr, "      In place: 0x%016llX\n", (unsigned long long)in_place[i]);
+            } else if (errors_found == MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    (Further hash mismatches suppressed...)\n");
+            }
+            errors_found++;
+        }
+    }
+
+    if (errors_found > 0) {
+        fprintf(stderr, "  Hash Test FAILED with %d mismatche(s).\n", errors_found);
+        return false;
+    }
+
+    return true;
+}
+
+bool run_test_partition_keys(const key_hash_test_case_t* test_case, const int64_t keys[]) {
+    static uint32_t partition_ids[KEY_COUNT];
+
+    printf("  Running Partition Test: Seed=0x%016llX, Partitions=%u\n",
+           (long long)test_case->seed, test_case->partition_count);
+
+    chi32_partition_keys(test_case->seed, keys, KEY_COUNT, test_case->partition_count, partition_ids);
+
+    int32_t errors_found = 0;
+
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        uint64_t hash = (uint64_t)chi32_apply_cascading_hash_interleave(test_case->seed, keys[i]);
+        uint32_t expected_id = (uint32_t)(((hash >> 32) * (uint64_t)test_case->partition_count) >> 32);
+        uint32_t single_id = chi32_partition_key(test_case->seed, keys[i], test_case->partition_count);
+
+        if (partition_ids[i] != expected_id || single_id != expected_id || expected_id >= test_case->partition_count) {
+            if (errors_found < MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    MISMATCH (Partition) at position %zu (Key: 0x%016llX):\n", i, (long long)keys[i]);
+                fprintf(stderr, "      Expected: %u, Batch: %u, Single: %u\n", expected_id, partition_ids[i], single_id);
+            } else if (errors_found == MAX_ERRORS_TO_PRINT) {
+                fprintf(stderr, "    (Further partition mismatches suppressed...)\n");
+            }
+            errors_found++;
+        }
+    }
+
+    if (errors_found > 0) {
+        fprintf(stderr, "  Partition Test FAILED with %d mismatche(s).\n", errors_found);
+        return false;
+    }
+
+    return true;
+}
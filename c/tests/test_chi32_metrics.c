@@ -0,0 +1,370 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "../src/chi32.h"
+#include "../src/chi32_batch.h"
+#include "../src/chi32_bernoulli.h"
+#include "../src/chi32_key_hash.h"
+#include "../src/chi32_metrics.h"
+
+#if !defined(CHI32_ENABLE_METRICS)
+#error "test_chi32_metrics.c must be compiled with -DCHI32_ENABLE_METRICS."
+#endif
+
+// --- Constants ---
+
+#define WORKER_THREAD_COUNT 4
+#define SCALAR_CALLS_PER_THREAD 100
+#define KEY_COUNT 37
+#define MAX_BATCH_COUNT 1000
+#define SHORT_LIVED_THREAD_COUNT 8
+#define SHORT_LIVED_BATCH_CALLS 10
+
+// --- Type Definitions ---
+
+typedef struct {
+    int64_t selector;
+    bool values_matched;
+} worker_args_t;
+
+// Per-thread workload; counts are chosen to land in distinct histogram buckets.
+static const size_t batch_counts[] = { 0, 1, 7, 8, 1000 };
+#define BATCH_CALLS_PER_THREAD (sizeof(batch_counts) / sizeof(batch_counts[0]))
+
+// --- Forward Declarations of Helper Functions ---
+
+void* run_worker(void* argument);
+uint64_t counter_delta(const chi32_metrics_snapshot_t* before, const chi32_metrics_snapshot_t* after,
+                       chi32_metrics_api_t api, size_t word);
+bool expect_counter(const char* label, uint64_t actual, uint64_t expected);
+bool run_test_per_api_counts(void);
+bool run_test_thread_blocks(void);
+bool run_test_csv_export(void);
+void* run_short_lived_worker(void* argument);
+bool run_test_block_reuse(void);
+
+
+// --- Main Function ---
+
+int main(void) {
+    printf("CHI32 C Implementation - Metrics Tests\n");
+    printf("=================================================\n");
+    printf("Refill timing: %s\n", chi32_metrics_read_cycles() != 0 ? "rdtsc" : "disabled");
+
+    bool all_overall_tests_passed = true;
+
+    printf("\n--- Processing Test Case: per_api_counts ---\n");
+    if (run_test_per_api_counts()) {
+        printf("  PASS: Test case 'per_api_counts' verified.\n");
+    } else {
+        fprintf(stderr, "  FAIL: Test case 'per_api_counts' failed.\n");
+        all_overall_tests_passed = false;
+    }
+
+    printf("\n--- Processing Test Case: thread_blocks ---\n");
+    if (run_test_thread_blocks()) {
+        printf("  PASS: Test case 'thread_blocks' verified.\n");
+    } else {
+        fprintf(stderr, "  FAIL: Test case 'thread_blocks' failed.\n");
+        all_overall_tests_passed = false;
+    }
+
+    printf("\n--- Processing Test Case: csv_export ---\n");
+    if (run_test_csv_export()) {
+        printf("  PASS: Test case 'csv_export' verified.\n");
+    } else {
+        fprintf(stderr, "  FAIL: Test case 'csv_export' failed.\n");
+        all_overall_tests_passed = false;
+    }
+
+    printf("\n--- Processing Test Case: block_reuse ---\n");
+    if (run_test_block_reuse()) {
+        printf("  PASS: Test case 'block_reuse' verified.\n");
+    } else {
+        fprintf(stderr, "  FAIL: Test case 'block_reuse' failed.\n");
+        all_overall_tests_passed = false;
+    }
+
+    printf("\n=================================================\n");
+    if (all_overall_tests_passed) {
+        printf("All CHI32 metrics tests PASSED.\n");
+        return EXIT_SUCCESS;
+    } else {
+        printf("One or more CHI32 metrics tests FAILED.\n");
+        return EXIT_FAILURE;
+    }
+}
+
+
+// --- Implementations of Helper Functions ---
+
+void* run_worker(void* argument) {
+    worker_args_t* args = (worker_args_t*)argument;
+    static const chi32_bernoulli_t half = { CHI32_BERNOULLI_DYADIC, 1, 1 };
+    int32_t values[MAX_BATCH_COUNT];
+    int64_t keys[KEY_COUNT];
+    uint64_t hashes[KEY_COUNT];
+    uint32_t partition_ids[KEY_COUNT];
+    uint32_t mask_words[10];
+    int32_t scalar_values[SCALAR_CALLS_PER_THREAD];
+
+    for (int i = 0; i < SCALAR_CALLS_PER_THREAD; ++i) {
+        scalar_values[i] = chi32_derive_value_at(args->selector, i);
+    }
+
+    args->values_matched = true;
+    for (size_t call = 0; call < BATCH_CALLS_PER_THREAD; ++call) {
+        chi32_derive_values_at(args->selector, 0, batch_counts[call], values);
+        for (size_t i = 0; i < batch_counts[call] && i < SCALAR_CALLS_PER_THREAD; ++i) {
+            args->values_matched &= values[i] == scalar_values[i];
+        }
+    }
+
+    chi32_derive_mask_words_at(args->selector, 0, 10, half, mask_words);
+    chi32_derive_mask_words_at(args->selector, 0, 10, chi32_bernoulli_probability(0.1), mask_words);
+    for (int64_t bit = 0; bit < 5; ++bit) {
+        (void)chi32_derive_mask_bit_at(args->selector, bit, half);
+    }
+
+    for (size_t i = 0; i < KEY_COUNT; ++i) {
+        keys[i] = (int64_t)i;
+    }
+    chi32_hash_keys(args->selector, keys, KEY_COUNT, hashes);
+    chi32_partition_keys(args->selector, keys, KEY_COUNT, 16, partition_ids);
+    args->values_matched &= chi32_hash_key(args->selector, keys[3]) == hashes[3];
+    args->values_matched &= chi32_partition_key(args->selector, keys[5], 16) == partition_ids[5];
+
+    return NULL;
+}
+
+uint64_t counter_delta(const chi32_metrics_snapshot_t* before, const chi32_metrics_snapshot_t* after,
+                       chi32_metrics_api_t api, size_t word) {
+    return (&after->counters[api].calls)[word] - (&before->counters[api].calls)[word];
+}
+
+bool expect_counter(const char* label, uint64_t actual, uint64_t expected) {
+    if (actual != expected) {
+        fprintf(stderr, "    MISMATCH (%s): expected %llu, actual %llu\n", label,
+                (unsigned long long)expected, (unsigned long long)actual);
+        return false;
+    }
+    return true;
+}
+
+bool run_test_per_api_counts(void) {
+    chi32_metrics_snapshot_t before;
+    chi32_metrics_snapshot_t after;
+    pthread_t threads[WORKER_THREAD_COUNT];
+    worker_args_t args[WORKER_THREAD_COUNT];
+    bool passed = true;
+
+    chi32_metrics_take_snapshot(&before);
+
+    for (int t = 0; t < WORKER_THREAD_COUNT; ++t) {
+        args[t].selector = (int64_t)0x6A09E667F3BCC908LL + t;
+        args[t].values_matched = false;
+        if (pthread_create(&threads[t], NULL, run_worker, &args[t]) != 0) {
+            fprintf(stderr, "    Failed to start worker thread %d.\n", t);
+            return false;
+        }
+    }
+    for (int t = 0; t < WORKER_THREAD_COUNT; ++t) {
+        pthread_join(threads[t], NULL);
+        if (!args[t].values_matched) {
+            fprintf(stderr, "    MISMATCH (Values): worker %d saw different values with metrics enabled\n", t);
+            passed = false;
+        }
+    }
+
+    // Counts of finished threads must remain in the totals.
+    chi32_metrics_take_snapshot(&after);
+
+    const uint64_t threads_u64 = WORKER_THREAD_COUNT;
+    uint64_t batch_values = 0;
+    for (size_t call = 0; call < BATCH_CALLS_PER_THREAD; ++call) {
+        batch_values += batch_counts[call];
+    }
+
+    // Each public entry point is counted once; nested internal calls are not.
+    passed &= expect_counter("scalar calls", counter_delta(&before, &after, CHI32_METRICS_API_SCALAR, 0),
+                             threads_u64 * SCALAR_CALLS_PER_THREAD);
+    passed &= expect_counter("scalar values", counter_delta(&before, &after, CHI32_METRICS_API_SCALAR, 1),
+                             threads_u64 * SCALAR_CALLS_PER_THREAD);
+    passed &= expect_counter("batch calls", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, 0),
+                             threads_u64 * BATCH_CALLS_PER_THREAD);
+    passed &= expect_counter("batch values", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, 1),
+                             threads_u64 * batch_values);
+    passed &= expect_counter("bernoulli calls", counter_delta(&before, &after, CHI32_METRICS_API_BERNOULLI, 0),
+                             threads_u64 * 2);
+    passed &= expect_counter("bernoulli words", counter_delta(&before, &after, CHI32_METRICS_API_BERNOULLI, 1),
+                             threads_u64 * 20);
+    passed &= expect_counter("bernoulli bit calls", counter_delta(&before, &after, CHI32_METRICS_API_BERNOULLI_BIT, 0),
+                             threads_u64 * 5);
+    passed &= expect_counter("bernoulli bits", counter_delta(&before, &after, CHI32_METRICS_API_BERNOULLI_BIT, 1),
+                             threads_u64 * 5);
+    passed &= expect_counter("key hash calls", counter_delta(&before, &after, CHI32_METRICS_API_KEY_HASH, 0),
+                             threads_u64 * 4);
+    passed &= expect_counter("key hash values", counter_delta(&before, &after, CHI32_METRICS_API_KEY_HASH, 1),
+                             threads_u64 * (2 * KEY_COUNT + 2));
+    passed &= expect_counter("view calls", counter_delta(&before, &after, CHI32_METRICS_API_VIEW, 0), 0);
+
+    // Histogram words follow calls, values and cycles; bucket k holds counts in [2^(k-1), 2^k).
+    const size_t histogram_word = 3;
+    passed &= expect_counter("batch bucket [0]", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, histogram_word + 0),
+                             threads_u64);
+    passed &= expect_counter("batch bucket [1]", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, histogram_word + 1),
+                             threads_u64);
+    passed &= expect_counter("batch bucket [4,7]", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, histogram_word + 3),
+                             threads_u64);
+    passed &= expect_counter("batch bucket [8,15]", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, histogram_word + 4),
+                             threads_u64);
+    passed &= expect_counter("batch bucket [512,1023]",
+                             counter_delta(&before, &after, CHI32_METRICS_API_BATCH, histogram_word + 10), threads_u64);
+    passed &= expect_counter("key hash bucket [32,63]",
+                             counter_delta(&before, &after, CHI32_METRICS_API_KEY_HASH, histogram_word + 6), threads_u64 * 2);
+
+    if (chi32_metrics_read_cycles() != 0 && counter_delta(&before, &after, CHI32_METRICS_API_BATCH, 2) == 0) {
+        fprintf(stderr, "    MISMATCH (batch cycles): timing is enabled but no cycles were recorded\n");
+        passed = false;
+    }
+    passed &= expect_counter("scalar cycles", counter_delta(&before, &after, CHI32_METRICS_API_SCALAR, 2), 0);
+
+    if (after.block_count < before.block_count + WORKER_THREAD_COUNT) {
+        fprintf(stderr, "    MISMATCH (threads): expected at least %llu registered blocks, found %llu\n",
+                (unsigned long long)(before.block_count + WORKER_THREAD_COUNT), (unsigned long long)after.block_count);
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool run_test_thread_blocks(void) {
+    bool passed = true;
+    size_t block_count = 0;
+    const chi32_metrics_thread_block_t* blocks[64];
+
+    for (chi32_metrics_thread_block_t* block = chi32_metrics_registry_head; block != NULL; block = block->next) {
+        if ((uintptr_t)block % CHI32_METRICS_CACHE_LINE_SIZE != 0) {
+            fprintf(stderr, "    MISMATCH (Alignment): block %p is not cache-line aligned\n", (const void*)block);
+            passed = false;
+        }
+        for (size_t i = 0; i < block_count && i < 64; ++i) {
+            // Blocks are padded to whole cache lines, so no two may share one.
+            uintptr_t distance = (uintptr_t)block > (uintptr_t)blocks[i] ? (uintptr_t)block - (uintptr_t)blocks[i]
+                                                                         : (uintptr_t)blocks[i] - (uintptr_t)block;
+            if (distance < sizeof(chi32_metrics_thread_block_t)) {
+                fprintf(stderr, "    MISMATCH (Isolation): blocks %p and %p overlap\n", (const void*)block,
+                        (const void*)blocks[i]);
+                passed = false;
+            }
+        }
+        if (block_count < 64) {
+            blocks[block_count] = block;
+        }
+        block_count++;
+    }
+
+    // The main thread registers its own block on first use.
+    (void)chi32_derive_value_at(0, 0);
+    if (chi32_metrics_current_thread_block == NULL || chi32_metrics_registry_head != chi32_metrics_current_thread_block) {
+        fprintf(stderr, "    MISMATCH (Registration): main thread block is not at the registry head\n");
+        passed = false;
+    }
+
+    printf("  Registered blocks before main thread: %zu\n", block_count);
+    return passed;
+}
+
+bool run_test_csv_export(void) {
+    chi32_metrics_snapshot_t snapshot;
+    char line[256];
+    bool saw_header = false;
+    bool saw_batch_totals = false;
+    bool saw_batch_bucket = false;
+
+    FILE* stream = tmpfile();
+    if (stream == NULL) {
+        fprintf(stderr, "    Could not create a temporary file.\n");
+        return false;
+    }
+
+    chi32_metrics_take_snapshot(&snapshot);
+    chi32_metrics_write_csv(stream, &snapshot);
+    rewind(stream);
+
+    while (fgets(line, sizeof(line), stream) != NULL) {
+        if (strcmp(line, "api,calls,values,cycles,bucket_min,bucket_max,bucket_calls\n") == 0) {
+            saw_header = true;
+        } else if (strncmp(line, "batch,", 6) == 0 && strstr(line, ",,,\n") != NULL) {
+            unsigned long long calls = 0;
+            saw_batch_totals = sscanf(line, "batch,%llu,", &calls) == 1 &&
+                               calls == snapshot.counters[CHI32_METRICS_API_BATCH].calls;
+        } else if (strstr(line, "batch,,,,512,1023,") == line) {
+            saw_batch_bucket = true;
+        }
+    }
+    fclose(stream);
+
+    if (!saw_header || !saw_batch_totals || !saw_batch_bucket) {
+        fprintf(stderr, "    MISMATCH (CSV): header %d, batch totals %d, batch bucket %d\n",
+                saw_header, saw_batch_totals, saw_batch_bucket);
+        return false;
+    }
+
+    return true;
+}
+
+void* run_short_lived_worker(void* argument) {
+    int32_t values[16];
+
+    for (int call = 0; call < SHORT_LIVED_BATCH_CALLS; ++call) {
+        chi32_derive_values_at(*(const int64_t*)argument, call, 16, values);
+    }
+    chi32_metrics_release_thread();
+
+    return NULL;
+}
+
+// Threads that release their block before exiting must not grow the registry.
+bool run_test_block_reuse(void) {
+    chi32_metrics_snapshot_t before;
+    chi32_metrics_snapshot_t after;
+    int64_t selector = 0x510E527FADE682D1LL;
+    bool passed = true;
+
+    chi32_metrics_take_snapshot(&before);
+
+    for (int t = 0; t < SHORT_LIVED_THREAD_COUNT; ++t) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, run_short_lived_worker, &selector) != 0) {
+            fprintf(stderr, "    Failed to start short-lived thread %d.\n", t);
+            return false;
+        }
+        pthread_join(thread, NULL);
+    }
+
+    chi32_metrics_take_snapshot(&after);
+
+    // Every earlier block is still owned, so the first thread allocates one block and the rest reuse it.
+    passed &= expect_counter("registered blocks", after.block_count, before.block_count + 1);
+    passed &= expect_counter("reused batch calls", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, 0),
+                             SHORT_LIVED_THREAD_COUNT * SHORT_LIVED_BATCH_CALLS);
+    passed &= expect_counter("reused batch values", counter_delta(&before, &after, CHI32_METRICS_API_BATCH, 1),
+                             SHORT_LIVED_THREAD_COUNT * SHORT_LIVED_BATCH_CALLS * 16);
+
+    // A released thread records into a claimed block again.
+    chi32_metrics_release_thread();
+    (void)chi32_derive_value_at(0, 0);
+    if (chi32_metrics_current_thread_block == NULL) {
+        fprintf(stderr, "    MISMATCH (Reclaim): main thread did not claim a block after releasing\n");
+        passed = false;
+    }
+
+    return passed;
+}
@@ -0,0 +1,294 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+#if __has_include(<execution>)
+#include <execution>
+#endif
+
+#include "../src/chi32.h"
+#include "../src/chi32_view.hpp"
+
+// --- Constants ---
+
+#define MAX_ERRORS_TO_PRINT 5
+
+// --- Type Definitions ---
+
+typedef struct {
+    const char* logical_name;
+    std::int64_t selector;
+    std::int64_t first;
+    std::int64_t last;
+} view_test_case_t;
+
+#if __cplusplus >= 202002L
+static_assert(std::ranges::random_access_range<chi32::value_view>);
+static_assert(std::ranges::sized_range<chi32::value_view>);
+static_assert(std::ranges::view<chi32::value_view>);
+static_assert(std::ranges::borrowed_range<chi32::value_view>);
+static_assert(std::random_access_iterator<chi32::value_iterator>);
+#endif
+
+// --- Forward Declarations of Helper Functions ---
+
+bool check_values(const char* label, const view_test_case_t* test_case, const std::vector<std::int32_t>& actual_values,
+                  bool reversed);
+bool run_test_forward_traversal(const view_test_case_t* test_case);
+bool run_test_backward_traversal(const view_test_case_t* test_case);
+bool run_test_random_access(const view_test_case_t* test_case);
+bool run_test_algorithms(const view_test_case_t* test_case);
+bool run_test_longer_than_int64_max();
+
+
+// --- Main Function ---
+
+int main() {
+    std::printf("CHI32 C++ View - Lazy Range Tests\n");
+    std::printf("=================================================\n");
+
+    const view_test_case_t test_cases[] = {
+        { "empty",              0x6A09E667F3BCC908LL,                    100,             100 },
+        { "shorter_than_block", 0x6A09E667F3BCC908LL,                    0,               5 },
+        { "several_blocks",     static_cast<std::int64_t>(0xFEDCBA9876543210ULL), -1000, 1003 },
+        { "near_index_limit",   0x0LL,                                   INT64_MAX - 40,  INT64_MAX },
+    };
+    const int num_test_cases = static_cast<int>(sizeof(test_cases) / sizeof(test_cases[0]));
+
+    bool all_overall_tests_passed = true;
+
+    for (int i = 0; i < num_test_cases; ++i) {
+        std::printf("\n--- Processing Test Case: %s ---\n", test_cases[i].logical_name);
+
+        bool current_test_passed = run_test_forward_traversal(&test_cases[i]);
+        current_test_passed &= run_test_backward_traversal(&test_cases[i]);
+        current_test_passed &= run_test_random_access(&test_cases[i]);
+        current_test_passed &= run_test_algorithms(&test_cases[i]);
+
+        if (current_test_passed) {
+            std::printf("  PASS: Test case '%s' verified.\n", test_cases[i].logical_name);
+        } else {
+            std::fprintf(stderr, "  FAIL: Test case '%s' failed.\n", test_cases[i].logical_name);
+            all_overall_tests_passed = false;
+        }
+    }
+
+    std::printf("\n--- Processing Test Case: longer_than_int64_max ---\n");
+    if (run_test_longer_than_int64_max()) {
+        std::printf("  PASS: Test case 'longer_than_int64_max' verified.\n");
+    } else {
+        std::fprintf(stderr, "  FAIL: Test case 'longer_than_int64_max' failed.\n");
+        all_overall_tests_passed = false;
+    }
+
+    std::printf("\n=================================================\n");
+    if (all_overall_tests_passed) {
+        std::printf("All CHI32 view tests PASSED.\n");
+        return EXIT_SUCCESS;
+    } else {
+        std::printf("One or more CHI32 view tests FAILED.\n");
+        return EXIT_FAILURE;
+    }
+}
+
+
+// --- Implementations of Helper Functions ---
+
+bool check_values(const char* label, const view_test_case_t* test_case, const std::vector<std::int32_t>& actual_values,
+                  bool reversed) {
+    const std::size_t expected_count = static_cast<std::size_t>(test_case->last - test_case->first);
+    int errors_found = 0;
+
+    if (actual_values.size() != expected_count) {
+        std::fprintf(stderr, "    SIZE MISMATCH (%s): expected %zu values, got %zu\n", label, expected_count, actual_values.size());
+        return false;
+    }
+
+    for (std::size_t i = 0; i < expected_count; ++i) {
+        std::size_t offset = reversed ? expected_count - 1 - i : i;
+        std::int64_t index = test_case->first + static_cast<std::int64_t>(offset);
+        std::uint32_t expected_value_u32 = static_cast<std::uint32_t>(chi32_derive_value_at(test_case->selector, index));
+        std::uint32_t actual_value_u32 = static_cast<std::uint32_t>(actual_values[i]);
+
+        if (actual_value_u32 != expected_value_u32) {
+            if (errors_found < MAX_ERRORS_TO_PRINT) {
+                std::fprintf(stderr, "    MISMATCH (%s) at index %lld: expected 0x%08X, actual 0x%08X\n",
+                             label, static_cast<long long>(index), expected_value_u32, actual_value_u32);
+            } else if (errors_found == MAX_ERRORS_TO_PRINT) {
+                std::fprintf(stderr, "    (Further %s mismatches suppressed...)\n", label);
+            }
+            errors_found++;
+        }
+    }
+
+    return errors_found == 0;
+}
+
+bool run_test_forward_traversal(const view_test_case_t* test_case) {
+    chi32::value_view values = chi32::view(test_case->selector, test_case->first, test_case->last);
+    std::vector<std::int32_t> collected;
+
+    for (std::int32_t value : values) {
+        collected.push_back(value);
+    }
+
+    // Post-increment and a copied iterator must see the same values.
+    std::vector<std::int32_t> collected_post;
+    for (chi32::value_iterator it = values.begin(); it != values.end();) {
+        chi32::value_iterator copy = it;
+        collected_post.push_back(*it++);
+        if (*copy != collected_post.back()) {
+            std::fprintf(stderr, "    MISMATCH (Forward): copied iterator disagrees at index %lld\n",
+                         static_cast<long long>(copy.index()));
+            return false;
+        }
+    }
+
+    return check_values("Forward", test_case, collected, false) &&
+           check_values("Forward Post-Increment", test_case, collected_post, false);
+}
+
+bool run_test_backward_traversal(const view_test_case_t* test_case) {
+    chi32::value_view values = chi32::view(test_case->selector, test_case->first, test_case->last);
+    std::vector<std::int32_t> collected(std::make_reverse_iterator(values.end()), std::make_reverse_iterator(values.begin()));
+
+    return check_values("Backward", test_case, collected, true);
+}
+
+bool run_test_random_access(const view_test_case_t* test_case) {
+    chi32::value_view values = chi32::view(test_case->selector, test_case->first, test_case->last);
+    const std::size_t count = values.size();
+    int errors_found = 0;
+
+    // Jump around, including stepping after a jump so that blocks are refilled mid-range.
+    for (std::size_t step = 0; step < count; ++step) {
+        std::size_t offset = (step * 7919U) % count;
+        chi32::value_iterator it = values.begin() + static_cast<std::int64_t>(offset);
+        std::int32_t expected_value = chi32_derive_value_at(test_case->selector, test_case->first + static_cast<std::int64_t>(offset));
+
+        bool matches = *it == expected_value && values[offset] == expected_value &&
+                       values.begin()[static_cast<std::int64_t>(offset)] == expected_value;
+        if (offset + 1 < count) {
+            ++it;
+            matches &= *it == chi32_derive_value_at(test_case->selector, test_case->first + static_cast<std::int64_t>(offset) + 1);
+            --it;
+            --it;
+            ++it;
+            matches &= *it == expected_value;
+        }
+
+        if (!matches) {
+            if (errors_found < MAX_ERRORS_TO_PRINT) {
+                std::fprintf(stderr, "    MISMATCH (Random Access) at offset %zu\n", offset);
+            }
+            errors_found++;
+        }
+    }
+
+    if (values.end() - values.begin() != static_cast<std::int64_t>(count)) {
+        std::fprintf(stderr, "    MISMATCH (Random Access): iterator distance differs from size\n");
+        errors_found++;
+    }
+
+    return errors_found == 0;
+}
+
+bool run_test_algorithms(const view_test_case_t* test_case) {
+    chi32::value_view values = chi32::view(test_case->selector, test_case->first, test_case->last);
+
+    std::vector<std::int32_t> transformed(values.size());
+    std::transform(values.begin(), values.end(), transformed.begin(), [](std::int32_t value) { return value; });
+    bool passed = check_values("std::transform", test_case, transformed, false);
+
+    std::int64_t expected_sum = std::accumulate(transformed.begin(), transformed.end(), std::int64_t{0});
+
+#if defined(__cpp_lib_execution) || defined(__cpp_lib_parallel_algorithm)
+    std::int64_t parallel_sum = std::transform_reduce(std::execution::par, values.begin(), values.end(), std::int64_t{0},
+                                                      std::plus<std::int64_t>(),
+                                                      [](std::int32_t value) { return static_cast<std::int64_t>(value); });
+    if (parallel_sum != expected_sum) {
+        std::fprintf(stderr, "    MISMATCH (std::execution::par): sum %lld, expected %lld\n",
+                     static_cast<long long>(parallel_sum), static_cast<long long>(expected_sum));
+        passed = false;
+    }
+
+    std::vector<std::int32_t> parallel_copy(values.size());
+    std::copy(std::execution::par_unseq, values.begin(), values.end(), parallel_copy.begin());
+    passed &= check_values("std::execution::par_unseq copy", test_case, parallel_copy, false);
+#endif
+
+#if __cplusplus >= 202002L
+    std::vector<std::int32_t> piped;
+    for (std::int32_t value : values | std::views::reverse | std::views::take(3)) {
+        piped.push_back(value);
+    }
+    std::vector<std::int32_t> expected_piped(transformed.rbegin(), transformed.rbegin() + static_cast<std::ptrdiff_t>(piped.size()));
+    if (piped != expected_piped || piped.size() != std::min<std::size_t>(3, values.size())) {
+        std::fprintf(stderr, "    MISMATCH (std::ranges pipeline)\n");
+        passed = false;
+    }
+
+    auto sorted_keys = transformed;
+    std::ranges::sort(sorted_keys);
+    if (!std::ranges::is_permutation(sorted_keys, values)) {
+        std::fprintf(stderr, "    MISMATCH (std::ranges::is_permutation)\n");
+        passed = false;
+    }
+#endif
+
+    return passed;
+}
+
+// [INT64_MIN, 1) holds 2^63 + 1 values; only both ends are traversed.
+bool run_test_longer_than_int64_max() {
+    const std::int64_t selector = 0x6A09E667F3BCC908LL;
+    chi32::value_view values = chi32::view(selector, INT64_MIN, 1);
+    const std::int64_t edge_count = 3 * chi32::value_iterator::block_length;
+    bool passed = true;
+
+    if (values.size() != (static_cast<std::size_t>(1) << 63) + 1) {
+        std::fprintf(stderr, "    MISMATCH (Size): expected 2^63 + 1, got %zu\n", values.size());
+        passed = false;
+    }
+
+    chi32::value_iterator it = values.begin();
+    for (std::int64_t offset = 0; offset < edge_count; ++offset, ++it) {
+        passed &= *it == chi32_derive_value_at(selector, INT64_MIN + offset);
+    }
+
+    it = values.end();
+    for (std::int64_t offset = 0; offset < edge_count; ++offset) {
+        --it;
+        passed &= *it == chi32_derive_value_at(selector, -offset);
+    }
+
+    if (!passed) {
+        std::fprintf(stderr, "    MISMATCH (Edges): values near the range ends differ\n");
+        return false;
+    }
+
+    // Subscripts and jumps beyond INT64_MAX positions from the start.
+    const std::size_t half_range = static_cast<std::size_t>(1) << 63;
+    passed &= values[0] == chi32_derive_value_at(selector, INT64_MIN);
+    passed &= values[half_range - 1] == chi32_derive_value_at(selector, -1);
+    passed &= values[half_range] == chi32_derive_value_at(selector, 0);
+    passed &= values[values.size() - 1] == chi32_derive_value_at(selector, 0);
+
+    it = values.begin();
+    it += INT64_MAX;
+    it += 1;
+    passed &= *it == chi32_derive_value_at(selector, 0) && it[INT64_MIN] == chi32_derive_value_at(selector, INT64_MIN);
+    it -= INT64_MAX;
+    it -= 1;
+    passed &= *it == chi32_derive_value_at(selector, INT64_MIN) && it[INT64_MAX] == chi32_derive_value_at(selector, -1);
+
+    if (!passed) {
+        std::fprintf(stderr, "    MISMATCH (Subscript): values far from the range start differ\n");
+    }
+    return passed;
+}
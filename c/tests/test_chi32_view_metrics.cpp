@@ -0,0 +1,153 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../src/chi32.h"
+#include "../src/chi32_view.hpp"
+#include "../src/chi32_metrics.h"
+
+#if !defined(CHI32_ENABLE_METRICS)
+#error "test_chi32_view_metrics.cpp must be compiled with -DCHI32_ENABLE_METRICS."
+#endif
+
+// --- Constants ---
+
+#define VIEW_LENGTH 100
+#define RANDOM_ACCESS_COUNT 10
+
+// Histogram words follow calls, values and cycles; bucket k holds counts in [2^(k-1), 2^k).
+#define HISTOGRAM_WORD 3
+
+// --- Forward Declarations of Helper Functions ---
+
+std::uint64_t counter_delta(const chi32_metrics_snapshot_t& before, const chi32_metrics_snapshot_t& after,
+                            chi32_metrics_api_t api, std::size_t word);
+bool expect_counter(const char* label, std::uint64_t actual, std::uint64_t expected);
+bool run_test_forward_walk();
+bool run_test_random_access();
+
+
+// --- Main Function ---
+
+int main() {
+    std::printf("CHI32 C++ View - Metrics Tests\n");
+    std::printf("=================================================\n");
+
+    bool all_overall_tests_passed = true;
+
+    std::printf("\n--- Processing Test Case: forward_walk ---\n");
+    if (run_test_forward_walk()) {
+        std::printf("  PASS: Test case 'forward_walk' verified.\n");
+    } else {
+        std::fprintf(stderr, "  FAIL: Test case 'forward_walk' failed.\n");
+        all_overall_tests_passed = false;
+    }
+
+    std::printf("\n--- Processing Test Case: random_access ---\n");
+    if (run_test_random_access()) {
+        std::printf("  PASS: Test case 'random_access' verified.\n");
+    } else {
+        std::fprintf(stderr, "  FAIL: Test case 'random_access' failed.\n");
+        all_overall_tests_passed = false;
+    }
+
+    std::printf("\n=================================================\n");
+    if (all_overall_tests_passed) {
+        std::printf("All CHI32 view metrics tests PASSED.\n");
+        return EXIT_SUCCESS;
+    } else {
+        std::printf("One or more CHI32 view metrics tests FAILED.\n");
+        return EXIT_FAILURE;
+    }
+}
+
+
+// --- Implementations of Helper Functions ---
+
+std::uint64_t counter_delta(const chi32_metrics_snapshot_t& before, const chi32_metrics_snapshot_t& after,
+                            chi32_metrics_api_t api, std::size_t word) {
+    return (&after.counters[api].calls)[word] - (&before.counters[api].calls)[word];
+}
+
+bool expect_counter(const char* label, std::uint64_t actual, std::uint64_t expected) {
+    if (actual != expected) {
+        std::fprintf(stderr, "    MISMATCH (%s): expected %llu, actual %llu\n", label,
+                     static_cast<unsigned long long>(expected), static_cast<unsigned long long>(actual));
+        return false;
+    }
+    return true;
+}
+
+// Walking [0, 100): the first dereference precedes any refill and is a single value;
+// each ++ leaving the block refills up to block_length values, clipped at the range end.
+bool run_test_forward_walk() {
+    const std::int64_t selector = 0x6A09E667F3BCC908LL;
+    const std::int64_t block_length = chi32::value_iterator::block_length;
+    const std::uint64_t full_refills = (VIEW_LENGTH - 1) / block_length;
+    const std::uint64_t partial_refill_length = (VIEW_LENGTH - 1) % block_length;
+    chi32_metrics_snapshot_t before;
+    chi32_metrics_snapshot_t after;
+    bool passed = true;
+
+    chi32::value_view values = chi32::view(selector, 0, VIEW_LENGTH);
+
+    chi32_metrics_take_snapshot(&before);
+    std::int64_t index = 0;
+    for (std::int32_t value : values) {
+        passed &= value == chi32_internal_extract_value(
+                               static_cast<std::uint64_t>(chi32_apply_cascading_hash_interleave(selector, index)));
+        ++index;
+    }
+    chi32_metrics_take_snapshot(&after);
+
+    if (!passed) {
+        std::fprintf(stderr, "    MISMATCH (Values): forward walk differs from the scalar primitive\n");
+    }
+
+    const std::uint64_t refill_calls = full_refills + (partial_refill_length > 0 ? 1 : 0);
+    passed &= expect_counter("view calls", counter_delta(before, after, CHI32_METRICS_API_VIEW, 0), refill_calls + 1);
+    passed &= expect_counter("view values", counter_delta(before, after, CHI32_METRICS_API_VIEW, 1), VIEW_LENGTH);
+    passed &= expect_counter("single-value bucket [1]",
+                             counter_delta(before, after, CHI32_METRICS_API_VIEW, HISTOGRAM_WORD + 1), 1);
+    passed &= expect_counter("full refill bucket [16,31]",
+                             counter_delta(before, after, CHI32_METRICS_API_VIEW, HISTOGRAM_WORD + 5), full_refills);
+    passed &= expect_counter("partial refill bucket [2,3]",
+                             counter_delta(before, after, CHI32_METRICS_API_VIEW, HISTOGRAM_WORD + 2), 1);
+
+    // Refills use the uninstrumented batch kernel, so nothing is counted twice.
+    passed &= expect_counter("batch calls", counter_delta(before, after, CHI32_METRICS_API_BATCH, 0), 0);
+    passed &= expect_counter("scalar calls", counter_delta(before, after, CHI32_METRICS_API_SCALAR, 0), 0);
+
+    return passed;
+}
+
+// Subscripts and jumps compute single values and never refill a block.
+bool run_test_random_access() {
+    const std::int64_t selector = static_cast<std::int64_t>(0xFEDCBA9876543210ULL);
+    chi32_metrics_snapshot_t before;
+    chi32_metrics_snapshot_t after;
+    bool passed = true;
+
+    chi32::value_view values = chi32::view(selector, -500, 500);
+
+    chi32_metrics_take_snapshot(&before);
+    for (std::size_t step = 0; step < RANDOM_ACCESS_COUNT; ++step) {
+        std::size_t offset = (step * 7919U) % values.size();
+        std::int32_t by_subscript = values[offset];
+        std::int32_t by_jump = *(values.begin() + static_cast<std::int64_t>(offset));
+        passed &= by_subscript == by_jump;
+    }
+    chi32_metrics_take_snapshot(&after);
+
+    if (!passed) {
+        std::fprintf(stderr, "    MISMATCH (Values): subscript and jump disagree\n");
+    }
+
+    passed &= expect_counter("view calls", counter_delta(before, after, CHI32_METRICS_API_VIEW, 0), 2 * RANDOM_ACCESS_COUNT);
+    passed &= expect_counter("view values", counter_delta(before, after, CHI32_METRICS_API_VIEW, 1), 2 * RANDOM_ACCESS_COUNT);
+    passed &= expect_counter("single-value bucket [1]",
+                             counter_delta(before, after, CHI32_METRICS_API_VIEW, HISTOGRAM_WORD + 1), 2 * RANDOM_ACCESS_COUNT);
+    passed &= expect_counter("scalar calls", counter_delta(before, after, CHI32_METRICS_API_SCALAR, 0), 0);
+
+    return passed;
+}
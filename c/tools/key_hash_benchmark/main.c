@@ -0,0 +1,194 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// --- Include the CHI32 header files ---
+#include "chi32.h"
+#include "chi32_key_hash.h"
+
+// --- Constants ---
+
+#define DEFAULT_KEY_COUNT (1U << 20)
+#define DEFAULT_ROUNDS 20
+#define PARTITION_COUNT 1000U
+#define DEFAULT_SEED 0x6A09E667F3BCC908LL
+
+// --- Type Definitions ---
+
+typedef void (*hash_batch_fn)(int64_t seed, const int64_t* keys, size_t count, uint64_t* hashes);
+typedef void (*partition_batch_fn)(int64_t seed, const int64_t* keys, size_t count, uint32_t partition_count, uint32_t* ids);
+
+typedef struct {
+    const char* name;
+    hash_batch_fn hash_batch;
+    partition_batch_fn partition_batch;
+} hasher_t;
+
+// --- Baseline integer hashers ---
+// Each baseline folds the seed into the key with XOR before finalizing, which is how
+// they are commonly seeded in hash tables. Partition IDs use the same multiply-shift
+// reduction as CHI32 so that only the hash function differs.
+
+static inline uint64_t splitmix64_finalizer(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static inline uint64_t murmur3_fmix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    return x ^ (x >> 33);
+}
+
+static inline uint64_t rotate_right_u64(uint64_t x, int k) {
+    return (x >> k) | (x << (64 - k));
+}
+
+// Pelle Evensen's rrmxmx mixer.
+static inline uint64_t rrmxmx(uint64_t x) {
+    x ^= rotate_right_u64(x, 49) ^ rotate_right_u64(x, 24);
+    x *= 0x9FB21C651E98DF25ULL;
+    x ^= x >> 28;
+    x *= 0x9FB21C651E98DF25ULL;
+    return x ^ (x >> 28);
+}
+
+// Fibonacci (multiply-shift) hashing: fast, but only the high bits are well mixed.
+static inline uint64_t fibonacci_hash(uint64_t x) {
+    return x * 0x9E3779B97F4A7C15ULL;
+}
+
+#define DEFINE_BASELINE(name, mixer)                                                                    \
+    static void name##_hash_batch(int64_t seed, const int64_t* keys, size_t count, uint64_t* hashes) { \
+        for (size_t i = 0; i < count; ++i) {                                                            \
+            hashes[i] = mixer((uint64_t)keys[i] ^ (uint64_t)seed);                                      \
+        }                                                                                               \
+    }                                                                                                   \
+    static void name##_partition_batch(int64_t seed, const int64_t* keys, size_t count,                \
+                                       uint32_t partition_count, uint32_t* ids) {                      \
+        for (size_t i = 0; i < count; ++i) {                                                            \
+            uint64_t hash = mixer((uint64_t)keys[i] ^ (uint64_t)seed);                                  \
+            ids[i] = (uint32_t)(((hash >> 32) * (uint64_t)partition_count) >> 32);                      \
+        }                                                                                               \
+    }
+
+DEFINE_BASELINE(splitmix64, splitmix64_finalizer)
+DEFINE_BASELINE(murmur3, murmur3_fmix64)
+DEFINE_BASELINE(rrmxmx, rrmxmx)
+DEFINE_BASELINE(fibonacci, fibonacci_hash)
+
+// --- CHI32 variants ---
+
+static void chi32_scalar_hash_batch(int64_t seed, const int64_t* keys, size_t count, uint64_t* hashes) {
+    for (size_t i = 0; i < count; ++i) {
+        hashes[i] = chi32_hash_key(seed, keys[i]);
+    }
+}
+
+static void chi32_scalar_partition_batch(int64_t seed, const int64_t* keys, size_t count,
+                                         uint32_t partition_count, uint32_t* ids) {
+    for (size_t i = 0; i < count; ++i) {
+        ids[i] = chi32_partition_key(seed, keys[i], partition_count);
+    }
+}
+
+// --- Measurement ---
+
+static double elapsed_seconds_since(const struct timespec* start_time) {
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    return (double)(end_time.tv_sec - start_time->tv_sec) + (double)(end_time.tv_nsec - start_time->tv_nsec) * 1e-9;
+}
+
+int main(int argc, char *argv[]) {
+    size_t key_count = DEFAULT_KEY_COUNT;
+    int rounds = DEFAULT_ROUNDS;
+
+    if (argc > 3) {
+        fprintf(stderr, "Usage: %s [key_count] [rounds]\n", argv[0]);
+        fprintf(stderr, "Example: %s %u %d\n", argv[0], DEFAULT_KEY_COUNT, DEFAULT_ROUNDS);
+        return 1;
+    }
+    if (argc >= 2) key_count = (size_t)strtoull(argv[1], NULL, 0);
+    if (argc >= 3) rounds = atoi(argv[2]);
+    if (key_count == 0 || rounds <= 0) {
+        fprintf(stderr, "Error: key_count and rounds must be positive.\n");
+        return 1;
+    }
+
+    const hasher_t hashers[] = {
+        { "chi32 (batch)",  chi32_hash_keys,            chi32_partition_keys },
+        { "chi32 (scalar)", chi32_scalar_hash_batch,    chi32_scalar_partition_batch },
+        { "splitmix64",     splitmix64_hash_batch,      splitmix64_partition_batch },
+        { "murmur3 fmix64", murmur3_hash_batch,         murmur3_partition_batch },
+        { "rrmxmx",         rrmxmx_hash_batch,          rrmxmx_partition_batch },
+        { "fibonacci",      fibonacci_hash_batch,       fibonacci_partition_batch },
+    };
+    const int hasher_count = (int)(sizeof(hashers) / sizeof(hashers[0]));
+
+    int64_t* keys = (int64_t*)malloc(key_count * sizeof(int64_t));
+    uint64_t* hashes = (uint64_t*)malloc(key_count * sizeof(uint64_t));
+    uint32_t* ids = (uint32_t*)malloc(key_count * sizeof(uint32_t));
+    if (keys == NULL || hashes == NULL || ids == NULL) {
+        fprintf(stderr, "Error: Failed to allocate %zu keys.\n", key_count);
+        return 1;
+    }
+
+    // Scattered keys, so that no hasher benefits from a trivially predictable input.
+    for (size_t i = 0; i < key_count; ++i) {
+        keys[i] = chi32_apply_cascading_hash_interleave(0, (int64_t)i);
+    }
+
+    printf("========================================\n");
+    printf(" CHI32 Key Hash Benchmark\n");
+    printf(" Keys: %zu, Rounds: %d, Partitions: %u, Batch kernel: %s\n",
+           key_count, rounds, PARTITION_COUNT, CHI32_BATCH_USE_AVX2 ? "AVX2" : "scalar");
+    printf("========================================\n\n");
+
+    printf("%-16s %14s %14s %14s %14s\n", "Hasher", "hash ns/key", "hash Mkeys/s", "part ns/key", "part Mkeys/s");
+    printf("----------------------------------------------------------------------------\n");
+
+    uint64_t checksum = 0;
+
+    for (int h = 0; h < hasher_count; ++h) {
+        struct timespec start_time;
+
+        hashers[h].hash_batch(DEFAULT_SEED, keys, key_count, hashes); // Warm-up
+        clock_gettime(CLOCK_MONOTONIC, &start_time);
+        for (int round = 0; round < rounds; ++round) {
+            hashers[h].hash_batch(DEFAULT_SEED + round, keys, key_count, hashes);
+            checksum += hashes[(size_t)round % key_count];
+        }
+        double hash_seconds = elapsed_seconds_since(&start_time);
+
+        hashers[h].partition_batch(DEFAULT_SEED, keys, key_count, PARTITION_COUNT, ids); // Warm-up
+        clock_gettime(CLOCK_MONOTONIC, &start_time);
+        for (int round = 0; round < rounds; ++round) {
+            hashers[h].partition_batch(DEFAULT_SEED + round, keys, key_count, PARTITION_COUNT, ids);
+            checksum += ids[(size_t)round % key_count];
+        }
+        double partition_seconds = elapsed_seconds_since(&start_time);
+
+        double total_keys = (double)key_count * (double)rounds;
+        printf("%-16s %14.3f %14.1f %14.3f %14.1f\n", hashers[h].name,
+               hash_seconds * 1e9 / total_keys, total_keys / hash_seconds / 1e6,
+               partition_seconds * 1e9 / total_keys, total_keys / partition_seconds / 1e6);
+    }
+
+    printf("----------------------------------------------------------------------------\n");
+    printf(" Checksum (ignore): %016llX\n", (unsigned long long)checksum);
+
+    free(keys);
+    free(hashes);
+    free(ids);
+
+    return 0;
+}
@@ -0,0 +1,789 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// --- Include the CHI32 header files ---
+#include "chi32.h"
+#include "chi32_batch.h"
+#include "chi32_key_hash.h"
+
+// --- Constants ---
+
+// The stream is processed in fixed-size chunks; each chunk is generated and
+// tested independently, which lets chunks be spread over worker threads.
+#define LOG2_CHUNK_LENGTH 18
+#define CHUNK_LENGTH ((size_t)1 << LOG2_CHUNK_LENGTH)
+
+#define MIN_LOG2_VALUE_COUNT (LOG2_CHUNK_LENGTH + 2)
+#define MAX_LOG2_VALUE_COUNT 40
+#define DEFAULT_LOG2_VALUE_COUNT 30
+#define MAX_THREAD_COUNT 256
+
+#define HISTOGRAM_BINS 65536
+
+// Byte-pair histograms: (0,1) and (2,3) double as the 16-bit frequency histograms.
+#define BYTE_PAIR_COUNT 6
+
+// Gap test: an event is a value below 2^28 (p = 1/16); the last bin collects longer gaps.
+#define GAP_EVENT_THRESHOLD 0x10000000U
+#define GAP_EVENT_PROBABILITY (1.0 / 16.0)
+#define GAP_BINS 128
+
+// Birthday spacings: each chunk yields one sample of m = 2^17 birthdays in n = 2^48 days,
+// giving a Poisson(lambda = m^3 / 4n = 2) count of duplicate spacings per sample.
+#define BIRTHDAY_COUNT (CHUNK_LENGTH / 2)
+#define BIRTHDAY_DAY_BITS 48
+#define BIRTHDAY_LAMBDA 2.0
+
+// Verdict thresholds (two-sided, as in TestU01 reports).
+#define SUSPICIOUS_P_VALUE 1e-4
+#define FAILURE_P_VALUE 1e-8
+
+// --- Type Definitions ---
+
+typedef enum {
+    STRATEGY_SEQUENTIAL,
+    STRATEGY_SWAPPED,
+    STRATEGY_FEEDBACK,
+    STRATEGY_UNKNOWN
+} strategy_kind_t;
+
+typedef enum {
+    KERNEL_SCALAR,
+    KERNEL_BATCH,
+    KERNEL_KEY_HASH,
+    KERNEL_UNKNOWN
+} kernel_kind_t;
+
+typedef struct {
+    int64_t seed;
+    int64_t phase;
+    strategy_kind_t strategy;
+    kernel_kind_t kernel;
+    int log2_value_count;
+    int thread_count;
+    uint64_t chunk_count;
+} battery_config_t;
+
+typedef struct {
+    int64_t selector;
+    int64_t index;
+} feedback_state_t;
+
+typedef struct {
+    uint32_t byte_pair_histograms[BYTE_PAIR_COUNT][HISTOGRAM_BINS];
+    uint32_t serial_pair_histogram[HISTOGRAM_BINS];
+    uint64_t gap_histogram[GAP_BINS];
+    uint64_t birthday_duplicates;
+    uint64_t birthday_samples;
+    uint64_t value_count;
+} battery_accumulators_t;
+
+typedef struct {
+    const battery_config_t* config;
+    int thread_id;
+    battery_accumulators_t* accumulators;
+    int32_t* values;
+    int64_t* key_buffer;
+    uint64_t* sort_buffer;
+    uint64_t* sort_scratch;
+    size_t* radix_counts;
+    feedback_state_t feedback_state;
+} worker_context_t;
+
+typedef struct {
+    const char* name;
+    double statistic;
+    double degrees_of_freedom;
+    double p_value;
+} test_result_t;
+
+// --- Forward declarations ---
+
+const char* strategy_to_string(strategy_kind_t strategy);
+const char* kernel_to_string(kernel_kind_t kernel);
+void fill_chunk(worker_context_t* context, uint64_t chunk_index);
+void accumulate_chunk(worker_context_t* context);
+void* run_worker(void* argument);
+int finalize_results(const battery_accumulators_t* totals, test_result_t results[]);
+const char* classify_p_value(double p_value);
+bool verify_p_value_conventions(void);
+double regularized_gamma_q(double a, double x);
+
+// --- Generator kernels ---
+
+const char* strategy_to_string(strategy_kind_t strategy) {
+    switch (strategy) {
+        case STRATEGY_SEQUENTIAL: return "sequential";
+        case STRATEGY_SWAPPED:    return "swapped";
+        case STRATEGY_FEEDBACK:   return "feedback";
+        default:                  return "unknown";
+    }
+}
+
+const char* kernel_to_string(kernel_kind_t kernel) {
+    switch (kernel) {
+        case KERNEL_SCALAR: return "scalar";
+        case KERNEL_BATCH:  return "batch";
+        case KERNEL_KEY_HASH: return "keyhash";
+        default:            return "unknown";
+    }
+}
+
+// Produces the values of one chunk. Chunk k covers stream positions [k * CHUNK_LENGTH, (k + 1) * CHUNK_LENGTH),
+// mapped to (selector, index) pairs exactly as in the TestU01 harness.
+void fill_chunk(worker_context_t* context, uint64_t chunk_index) {
+    const battery_config_t* config = context->config;
+    feedback_state_t* feedback_state = &context->feedback_state;
+    int32_t* values = context->values;
+    uint64_t first_position = chunk_index * CHUNK_LENGTH;
+
+    switch (config->strategy) {
+        case STRATEGY_SEQUENTIAL: {
+            int64_t first_index = (int64_t)((uint64_t)config->phase + first_position);
+            if (config->kernel == KERNEL_KEY_HASH) {
+                // Keys are consecutive from PHASE; each 64-bit hash contributes its low and high words.
+                size_t key_count = CHUNK_LENGTH / 2;
+                uint64_t first_key_u64 = (uint64_t)config->phase + first_position / 2;
+                uint64_t* hashes = (uint64_t*)context->sort_buffer;
+
+                for (size_t i = 0; i < key_count; ++i) {
+                    context->key_buffer[i] = (int64_t)(first_key_u64 + i);
+                }
+                chi32_hash_keys(config->seed, context->key_buffer, key_count, hashes);
+                for (size_t i = 0; i < key_count; ++i) {
+                    values[2 * i] = (int32_t)(uint32_t)hashes[i];
+                    values[2 * i + 1] = (int32_t)(uint32_t)(hashes[i] >> 32);
+                }
+            } else if (config->kernel == KERNEL_BATCH) {
+                chi32_derive_values_at(config->seed, first_index, CHUNK_LENGTH, values);
+            } else {
+                for (size_t i = 0; i < CHUNK_LENGTH; ++i) {
+                    values[i] = chi32_derive_value_at(config->seed, (int64_t)((uint64_t)first_index + i));
+                }
+            }
+            break;
+        }
+        case STRATEGY_SWAPPED: {
+            uint64_t first_selector_u64 = (uint64_t)config->phase - first_position;
+            for (size_t i = 0; i < CHUNK_LENGTH; ++i) {
+                values[i] = chi32_derive_value_at((int64_t)(first_selector_u64 - i), config->seed);
+            }
+            break;
+        }
+        case STRATEGY_FEEDBACK: {
+            // Chunks are processed in order by a single worker, so the state simply carries over.
+            for (size_t i = 0; i < CHUNK_LENGTH; ++i) {
+                uint32_t result_u32 = (uint32_t)chi32_derive_value_at(feedback_state->selector, feedback_state->index);
+
+                uint64_t prev_seed_u64 = (uint64_t)feedback_state->selector;
+                uint64_t prev_phase_u64 = (uint64_t)feedback_state->index;
+
+                feedback_state->selector = (int64_t)((prev_seed_u64 << 32) | (prev_phase_u64 >> 32));
+                feedback_state->index = (int64_t)((prev_phase_u64 << 32) | (uint64_t)result_u32);
+
+                values[i] = (int32_t)result_u32;
+            }
+            break;
+        }
+        default:
+            fprintf(stderr, "FATAL: Unknown strategy in fill_chunk. Exiting.\n");
+            exit(EXIT_FAILURE);
+    }
+}
+
+// --- Per-chunk test accumulation ---
+
+#define RADIX_SIZE ((size_t)1 << 16)
+
+static void sort_u64_by_16_bit_digits(uint64_t* keys, uint64_t* scratch, size_t* digit_counts, size_t count, int key_bits) {
+    for (int shift = 0; shift < key_bits; shift += 16) {
+        memset(digit_counts, 0, RADIX_SIZE * sizeof(size_t));
+        for (size_t i = 0; i < count; ++i) {
+            digit_counts[(keys[i] >> shift) & 0xFFFFU]++;
+        }
+
+        size_t offset = 0;
+        for (size_t digit = 0; digit < RADIX_SIZE; ++digit) {
+            size_t digit_count = digit_counts[digit];
+            digit_counts[digit] = offset;
+            offset += digit_count;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            scratch[digit_counts[(keys[i] >> shift) & 0xFFFFU]++] = keys[i];
+        }
+        memcpy(keys, scratch, count * sizeof(keys[0]));
+    }
+}
+
+void accumulate_chunk(worker_context_t* context) {
+    battery_accumulators_t* acc = context->accumulators;
+    const uint32_t* values = (const uint32_t*)context->values;
+
+    // Frequency and bit-independence: six independent byte-pair histograms per value
+    // keep several increments in flight instead of serializing on a single table.
+    uint32_t* histogram_01 = acc->byte_pair_histograms[0];
+    uint32_t* histogram_23 = acc->byte_pair_histograms[1];
+    uint32_t* histogram_02 = acc->byte_pair_histograms[2];
+    uint32_t* histogram_13 = acc->byte_pair_histograms[3];
+    uint32_t* histogram_03 = acc->byte_pair_histograms[4];
+    uint32_t* histogram_12 = acc->byte_pair_histograms[5];
+
+    for (size_t i = 0; i < CHUNK_LENGTH; ++i) {
+        uint32_t value = values[i];
+        histogram_01[value & 0xFFFFU]++;
+        histogram_23[value >> 16]++;
+        histogram_02[(value & 0xFFU) | ((value >> 8) & 0xFF00U)]++;
+        histogram_13[((value >> 8) & 0xFFU) | ((value >> 16) & 0xFF00U)]++;
+        histogram_03[(value & 0xFFU) | ((value >> 16) & 0xFF00U)]++;
+        histogram_12[(value >> 8) & 0xFFFFU]++;
+    }
+
+    // Serial pairs: top bytes of non-overlapping consecutive pairs.
+    for (size_t i = 0; i < CHUNK_LENGTH; i += 2) {
+        acc->serial_pair_histogram[((values[i] >> 24) << 8) | (values[i + 1] >> 24)]++;
+    }
+
+    // Gaps between events; the partial gap before the first event of a chunk is discarded.
+    int64_t gap_length = -1;
+    for (size_t i = 0; i < CHUNK_LENGTH; ++i) {
+        if (values[i] < GAP_EVENT_THRESHOLD) {
+            if (gap_length >= 0) {
+                acc->gap_histogram[gap_length < GAP_BINS - 1 ? gap_length : GAP_BINS - 1]++;
+            }
+            gap_length = 0;
+        } else if (gap_length >= 0) {
+            gap_length++;
+        }
+    }
+
+    // Birthday spacings over 48-bit birthdays built from value pairs.
+    uint64_t* birthdays = context->sort_buffer;
+    for (size_t i = 0; i < BIRTHDAY_COUNT; ++i) {
+        birthdays[i] = ((uint64_t)values[2 * i] << 16) | (values[2 * i + 1] >> 16);
+    }
+    sort_u64_by_16_bit_digits(birthdays, context->sort_scratch, context->radix_counts, BIRTHDAY_COUNT, BIRTHDAY_DAY_BITS);
+
+    for (size_t i = BIRTHDAY_COUNT - 1; i > 0; --i) {
+        birthdays[i] -= birthdays[i - 1];
+    }
+    sort_u64_by_16_bit_digits(birthdays + 1, context->sort_scratch, context->radix_counts, BIRTHDAY_COUNT - 1, BIRTHDAY_DAY_BITS);
+
+    for (size_t i = 2; i < BIRTHDAY_COUNT; ++i) {
+        acc->birthday_duplicates += birthdays[i] == birthdays[i - 1];
+    }
+    acc->birthday_samples++;
+
+    acc->value_count += CHUNK_LENGTH;
+}
+
+void* run_worker(void* argument) {
+    worker_context_t* context = (worker_context_t*)argument;
+    const battery_config_t* config = context->config;
+
+    for (uint64_t chunk_index = (uint64_t)context->thread_id; chunk_index < config->chunk_count;
+         chunk_index += (uint64_t)config->thread_count) {
+        fill_chunk(context, chunk_index);
+        accumulate_chunk(context);
+    }
+
+    return NULL;
+}
+
+// --- Statistics ---
+
+// Regularized lower incomplete gamma P(a, x) by its power series (x < a + 1).
+static double regularized_gamma_p_series(double a, double x) {
+    double term = 1.0 / a;
+    double sum = term;
+
+    for (int n = 1; n < 1000000; ++n) {
+        term *= x / (a + n);
+        sum += term;
+        if (fabs(term) < fabs(sum) * 1e-16) {
+            break;
+        }
+    }
+
+    return sum * exp(-x + a * log(x) - lgamma(a));
+}
+
+// Regularized upper incomplete gamma Q(a, x) by its continued fraction (x >= a + 1).
+static double regularized_gamma_q_continued_fraction(double a, double x) {
+    const double tiny = 1e-300;
+    double b = x + 1.0 - a;
+    double c = 1.0 / tiny;
+    double d = 1.0 / b;
+    double h = d;
+
+    for (int n = 1; n < 1000000; ++n) {
+        double an = -n * (n - a);
+        b += 2.0;
+        d = an * d + b;
+        if (fabs(d) < tiny) d = tiny;
+        c = b + an / c;
+        if (fabs(c) < tiny) c = tiny;
+        d = 1.0 / d;
+        double delta = d * c;
+        h *= delta;
+        if (fabs(delta - 1.0) < 1e-16) {
+            break;
+        }
+    }
+
+    return exp(-x + a * log(x) - lgamma(a)) * h;
+}
+
+double regularized_gamma_q(double a, double x) {
+    if (x <= 0.0) {
+        return 1.0;
+    }
+    if (x < a + 1.0) {
+        return 1.0 - regularized_gamma_p_series(a, x);
+    }
+    return regularized_gamma_q_continued_fraction(a, x);
+}
+
+static double chi_square_p_value(double statistic, double degrees_of_freedom) {
+    return regularized_gamma_q(degrees_of_freedom / 2.0, statistic / 2.0);
+}
+
+static double chi_square_uniform(const uint64_t* counts, size_t bin_count, uint64_t total) {
+    double expected = (double)total / (double)bin_count;
+    double statistic = 0.0;
+
+    for (size_t i = 0; i < bin_count; ++i) {
+        double difference = (double)counts[i] - expected;
+        statistic += difference * difference / expected;
+    }
+
+    return statistic;
+}
+
+// Fills the bit-pair co-occurrence counts of the two bytes covered by a byte-pair histogram.
+static void accumulate_bit_pairs(const uint64_t* histogram, int low_byte, int high_byte, uint64_t joint_counts[32][32]) {
+    uint64_t local_counts[16][16];
+    memset(local_counts, 0, sizeof(local_counts));
+
+    for (uint32_t key = 0; key < HISTOGRAM_BINS; ++key) {
+        uint64_t count = histogram[key];
+        if (count == 0) continue;
+        for (int x = 0; x < 16; ++x) {
+            if (!((key >> x) & 1U)) continue;
+            for (int y = x; y < 16; ++y) {
+                if ((key >> y) & 1U) local_counts[x][y] += count;
+            }
+        }
+    }
+
+    for (int x = 0; x < 16; ++x) {
+        int global_x = x < 8 ? low_byte * 8 + x : high_byte * 8 + (x - 8);
+        for (int y = x; y < 16; ++y) {
+            int global_y = y < 8 ? low_byte * 8 + y : high_byte * 8 + (y - 8);
+            joint_counts[global_x][global_y] = local_counts[x][y];
+            joint_counts[global_y][global_x] = local_counts[x][y];
+        }
+    }
+}
+
+// Share of recorded gaps per bin. Only gaps that end inside their chunk are recorded,
+// so a gap of length g fits at chunk_length - g - 1 positions: weight q^g * (chunk_length - g - 1).
+// Plain geometric q^g would under-predict short gaps by about Var(g) / chunk_length.
+static void gap_bin_probabilities(size_t chunk_length, double probabilities[GAP_BINS]) {
+    const double miss_probability = 1.0 - GAP_EVENT_PROBABILITY;
+    double miss_power = 1.0;
+    double total = 0.0;
+
+    for (int i = 0; i < GAP_BINS; ++i) probabilities[i] = 0.0;
+
+    for (size_t g = 0; g + 1 < chunk_length && miss_power > 1e-300; ++g) {
+        double weight = miss_power * (double)(chunk_length - g - 1);
+        probabilities[g < GAP_BINS - 1 ? g : GAP_BINS - 1] += weight;
+        total += weight;
+        miss_power *= miss_probability;
+    }
+
+    for (int i = 0; i < GAP_BINS; ++i) probabilities[i] /= total;
+}
+
+static double gap_chi_square(const uint64_t histogram[GAP_BINS], size_t chunk_length) {
+    double probabilities[GAP_BINS];
+    uint64_t gap_total = 0;
+    double statistic = 0.0;
+
+    gap_bin_probabilities(chunk_length, probabilities);
+    for (int i = 0; i < GAP_BINS; ++i) gap_total += histogram[i];
+
+    for (int i = 0; i < GAP_BINS; ++i) {
+        double expected = probabilities[i] * (double)gap_total;
+        double difference = (double)histogram[i] - expected;
+        statistic += difference * difference / expected;
+    }
+
+    return statistic;
+}
+
+static double poisson_mid_p_value(uint64_t observed, double lambda) {
+    // One-sided mid-p, P(X < k) + P(X = k) / 2, so the shared two-sided verdict applies.
+    // P(X < k) = Q(k, lambda) and P(X <= k) = Q(k + 1, lambda).
+    double below = observed == 0 ? 0.0 : regularized_gamma_q((double)observed, lambda);
+    double at_or_below = regularized_gamma_q((double)observed + 1.0, lambda);
+
+    return 0.5 * (below + at_or_below);
+}
+
+int finalize_results(const battery_accumulators_t* totals, test_result_t results[]) {
+    static uint64_t histogram[HISTOGRAM_BINS];
+    static const int byte_pairs[BYTE_PAIR_COUNT][2] = { {0, 1}, {2, 3}, {0, 2}, {1, 3}, {0, 3}, {1, 2} };
+    static uint64_t joint_counts[32][32];
+    int result_count = 0;
+    uint64_t n = totals->value_count;
+
+    // Frequency: low and high 16-bit halves.
+    for (int half = 0; half < 2; ++half) {
+        for (size_t i = 0; i < HISTOGRAM_BINS; ++i) histogram[i] = totals->byte_pair_histograms[half][i];
+        double statistic = chi_square_uniform(histogram, HISTOGRAM_BINS, n);
+        results[result_count].name = half == 0 ? "frequency (low 16 bits)" : "frequency (high 16 bits)";
+        results[result_count].statistic = statistic;
+        results[result_count].degrees_of_freedom = HISTOGRAM_BINS - 1;
+        results[result_count].p_value = chi_square_p_value(statistic, HISTOGRAM_BINS - 1);
+        result_count++;
+    }
+
+    // Serial pairs.
+    for (size_t i = 0; i < HISTOGRAM_BINS; ++i) histogram[i] = totals->serial_pair_histogram[i];
+    {
+        double statistic = chi_square_uniform(histogram, HISTOGRAM_BINS, n / 2);
+        results[result_count].name = "serial pairs (top bytes)";
+        results[result_count].statistic = statistic;
+        results[result_count].degrees_of_freedom = HISTOGRAM_BINS - 1;
+        results[result_count].p_value = chi_square_p_value(statistic, HISTOGRAM_BINS - 1);
+        result_count++;
+    }
+
+    // Gaps: geometric distribution, corrected for the unfinished gap each chunk drops.
+    {
+        double statistic = gap_chi_square(totals->gap_histogram, CHUNK_LENGTH);
+        results[result_count].name = "gaps (p = 1/16)";
+        results[result_count].statistic = statistic;
+        results[result_count].degrees_of_freedom = GAP_BINS - 1;
+        results[result_count].p_value = chi_square_p_value(statistic, GAP_BINS - 1);
+        result_count++;
+    }
+
+    // Birthday spacings: the total duplicate count is Poisson(samples * lambda).
+    {
+        double lambda = BIRTHDAY_LAMBDA * (double)totals->birthday_samples;
+        results[result_count].name = "birthday spacings";
+        results[result_count].statistic = (double)totals->birthday_duplicates;
+        results[result_count].degrees_of_freedom = 0;
+        results[result_count].p_value = poisson_mid_p_value(totals->birthday_duplicates, lambda);
+        result_count++;
+    }
+
+    // Bit independence: per-bit balance and 2x2 contingency for every bit pair within a value.
+    for (int pair = 0; pair < BYTE_PAIR_COUNT; ++pair) {
+        for (size_t i = 0; i < HISTOGRAM_BINS; ++i) histogram[i] = totals->byte_pair_histograms[pair][i];
+        accumulate_bit_pairs(histogram, byte_pairs[pair][0], byte_pairs[pair][1], joint_counts);
+    }
+    {
+        double total = (double)n;
+        double balance_statistic = 0.0;
+        double pair_statistic = 0.0;
+
+        for (int i = 0; i < 32; ++i) {
+            double ones_i = (double)joint_counts[i][i];
+            double difference = 2.0 * ones_i - total;
+            balance_statistic += difference * difference / total;
+
+            for (int j = i + 1; j < 32; ++j) {
+                double ones_j = (double)joint_counts[j][j];
+                double both = (double)joint_counts[i][j];
+                double numerator = total * both - ones_i * ones_j;
+                double denominator = ones_i * (total - ones_i) * ones_j * (total - ones_j);
+                pair_statistic += total * numerator * numerator / denominator;
+            }
+        }
+
+        results[result_count].name = "bit balance";
+        results[result_count].statistic = balance_statistic;
+        results[result_count].degrees_of_freedom = 32;
+        results[result_count].p_value = chi_square_p_value(balance_statistic, 32);
+        result_count++;
+
+        results[result_count].name = "bit independence (pairs)";
+        results[result_count].statistic = pair_statistic;
+        results[result_count].degrees_of_freedom = 32 * 31 / 2;
+        results[result_count].p_value = chi_square_p_value(pair_statistic, 32 * 31 / 2);
+        result_count++;
+    }
+
+    return result_count;
+}
+
+// --- Main smoke battery ---
+// Every p-value is one-sided; the verdict judges both tails.
+const char* classify_p_value(double p_value) {
+    double tail = p_value < 1.0 - p_value ? p_value : 1.0 - p_value;
+
+    if (tail < FAILURE_P_VALUE) return "FAIL";
+    if (tail < SUSPICIOUS_P_VALUE) return "suspicious";
+    return "ok";
+}
+
+// Guards the statistics against verdict mistakes, e.g. a birthday count at its
+// expected value (the most likely outcome) being judged as an extreme tail.
+bool verify_p_value_conventions(void) {
+    static const double lambdas[] = { 8.0, 128.0, BIRTHDAY_LAMBDA * 4096.0 };
+    bool passed = true;
+
+    for (size_t i = 0; i < sizeof(lambdas) / sizeof(lambdas[0]); ++i) {
+        double lambda = lambdas[i];
+        double at_mean = poisson_mid_p_value((uint64_t)lambda, lambda);
+        double far_below = poisson_mid_p_value(0, lambda);
+        double far_above = poisson_mid_p_value((uint64_t)(lambda + 20.0 * sqrt(lambda)), lambda);
+
+        passed &= strcmp(classify_p_value(at_mean), "ok") == 0 && at_mean > 0.3 && at_mean < 0.7;
+        if (lambda >= 128.0) { // With small lambda even zero duplicates is not extreme.
+            passed &= strcmp(classify_p_value(far_below), "FAIL") == 0;
+            passed &= strcmp(classify_p_value(far_above), "FAIL") == 0;
+        }
+    }
+
+    // Gap bias: noise-free counts from 2^16 chunks of 2^10 values (a larger gaps-to-chunk-length
+    // ratio than a 2^40-value run) must fit the gap model; plain geometric must not.
+    {
+        const size_t chunk_length = 1024;
+        const double chunk_count = 65536.0;
+        const double miss_probability = 1.0 - GAP_EVENT_PROBABILITY;
+        uint64_t gap_histogram[GAP_BINS] = { 0 };
+        double tail_count = 0.0;
+
+        for (size_t g = 0; g + 1 < chunk_length; ++g) {
+            double expected = chunk_count * (double)(chunk_length - g - 1) * GAP_EVENT_PROBABILITY *
+                              GAP_EVENT_PROBABILITY * pow(miss_probability, (double)g);
+            if (g < GAP_BINS - 1) {
+                gap_histogram[g] = (uint64_t)llround(expected);
+            } else {
+                tail_count += expected;
+            }
+        }
+        gap_histogram[GAP_BINS - 1] = (uint64_t)llround(tail_count);
+
+        // An effectively unbounded chunk reproduces the plain geometric model.
+        passed &= gap_chi_square(gap_histogram, chunk_length) < 1.0;
+        passed &= gap_chi_square(gap_histogram, (size_t)1 << 40) > 100.0;
+    }
+
+    passed &= strcmp(classify_p_value(chi_square_p_value(1.0, 1.0)), "ok") == 0;
+    passed &= strcmp(classify_p_value(chi_square_p_value(200.0, 1.0)), "FAIL") == 0;
+
+    return passed;
+}
+
+int main(int argc, char *argv[]) {
+    battery_config_t config;
+    char *endptr_seed, *endptr_phase;
+
+    if (!verify_p_value_conventions()) {
+        fprintf(stderr, "Error: p-value self-check failed; verdicts would be unreliable.\n");
+        return 1;
+    }
+
+    // --- Argument parsing ---
+    if (argc < 3 || argc > 7) {
+        fprintf(stderr, "Usage: %s <hex_seed> <hex_phase> [strategy_name] [kernel_name] [log2_value_count] [thread_count]\n", argv[0]);
+        fprintf(stderr, "Example: %s 0x6A09E667F3BCC908 0 sequential batch 32 8\n", argv[0]);
+        fprintf(stderr, "Available strategy_names: sequential (default), swapped, feedback\n");
+        fprintf(stderr, "Available kernel_names: scalar (default), batch, keyhash (batch and keyhash: sequential strategy only)\n");
+        fprintf(stderr, "log2_value_count: %d..%d (default %d); thread_count: default is the number of online CPUs\n",
+                MIN_LOG2_VALUE_COUNT, MAX_LOG2_VALUE_COUNT, DEFAULT_LOG2_VALUE_COUNT);
+        return 1;
+    }
+
+    config.seed = (int64_t)strtoull(argv[1], &endptr_seed, 0);
+    if (*endptr_seed != '\0') {
+        fprintf(stderr, "Error: Invalid seed argument '%s'\n", argv[1]);
+        return 1;
+    }
+
+    config.phase = (int64_t)strtoull(argv[2], &endptr_phase, 0);
+    if (*endptr_phase != '\0') {
+        fprintf(stderr, "Error: Invalid phase argument '%s'\n", argv[2]);
+        return 1;
+    }
+
+    config.strategy = STRATEGY_SEQUENTIAL;
+    if (argc >= 4) {
+        if (strcmp(argv[3], "sequential") == 0) {
+            config.strategy = STRATEGY_SEQUENTIAL;
+        } else if (strcmp(argv[3], "swapped") == 0) {
+            config.strategy = STRATEGY_SWAPPED;
+        } else if (strcmp(argv[3], "feedback") == 0) {
+            config.strategy = STRATEGY_FEEDBACK;
+        } else {
+            fprintf(stderr, "Error: Invalid strategy_name '%s'. Available: sequential, swapped, feedback.\n", argv[3]);
+            return 1;
+        }
+    }
+
+    config.kernel = KERNEL_SCALAR;
+    if (argc >= 5) {
+        if (strcmp(argv[4], "scalar") == 0) {
+            config.kernel = KERNEL_SCALAR;
+        } else if (strcmp(argv[4], "batch") == 0) {
+            config.kernel = KERNEL_BATCH;
+        } else if (strcmp(argv[4], "keyhash") == 0) {
+            config.kernel = KERNEL_KEY_HASH;
+        } else {
+            fprintf(stderr, "Error: Invalid kernel_name '%s'. Available: scalar, batch, keyhash.\n", argv[4]);
+            return 1;
+        }
+    }
+    if (config.kernel != KERNEL_SCALAR && config.strategy != STRATEGY_SEQUENTIAL) {
+        fprintf(stderr, "Error: The %s kernel only supports the sequential strategy.\n", kernel_to_string(config.kernel));
+        return 1;
+    }
+
+    config.log2_value_count = argc >= 6 ? atoi(argv[5]) : DEFAULT_LOG2_VALUE_COUNT;
+    if (config.log2_value_count < MIN_LOG2_VALUE_COUNT || config.log2_value_count > MAX_LOG2_VALUE_COUNT) {
+        fprintf(stderr, "Error: log2_value_count must be in %d..%d.\n", MIN_LOG2_VALUE_COUNT, MAX_LOG2_VALUE_COUNT);
+        return 1;
+    }
+    config.chunk_count = (uint64_t)1 << (config.log2_value_count - LOG2_CHUNK_LENGTH);
+
+    long online_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    config.thread_count = argc >= 7 ? atoi(argv[6]) : (online_cpus > 0 ? (int)online_cpus : 1);
+    if (config.thread_count < 1 || config.thread_count > MAX_THREAD_COUNT) {
+        fprintf(stderr, "Error: thread_count must be in 1..%d.\n", MAX_THREAD_COUNT);
+        return 1;
+    }
+    if (config.strategy == STRATEGY_FEEDBACK) {
+        config.thread_count = 1; // Each value depends on the previous one.
+    }
+    if ((uint64_t)config.thread_count > config.chunk_count) {
+        config.thread_count = (int)config.chunk_count;
+    }
+
+    printf("========================================\n");
+    printf(" Starting CHI32 Smoke Battery (Strategy=%s, Kernel=%s, Seed=0x%016llX, InitialPhase=0x%016llX)\n",
+           strategy_to_string(config.strategy), kernel_to_string(config.kernel),
+           (long long)config.seed, (long long)config.phase);
+    printf(" Values: 2^%d (%.2f GiB), Threads: %d, Batch kernel: %s\n",
+           config.log2_value_count, (double)((uint64_t)1 << config.log2_value_count) * 4.0 / (1024.0 * 1024.0 * 1024.0),
+           config.thread_count, CHI32_BATCH_USE_AVX2 ? "AVX2" : "scalar");
+    printf("========================================\n\n");
+    fflush(stdout);
+
+    // --- Run workers ---
+    worker_context_t* contexts = (worker_context_t*)calloc((size_t)config.thread_count, sizeof(worker_context_t));
+    pthread_t* threads = (pthread_t*)calloc((size_t)config.thread_count, sizeof(pthread_t));
+    if (contexts == NULL || threads == NULL) {
+        fprintf(stderr, "Error: Failed to allocate worker state.\n");
+        return 1;
+    }
+
+    for (int t = 0; t < config.thread_count; ++t) {
+        contexts[t].config = &config;
+        contexts[t].thread_id = t;
+        contexts[t].accumulators = (battery_accumulators_t*)calloc(1, sizeof(battery_accumulators_t));
+        contexts[t].values = (int32_t*)malloc(CHUNK_LENGTH * sizeof(int32_t));
+        contexts[t].key_buffer = (int64_t*)malloc(BIRTHDAY_COUNT * sizeof(int64_t));
+        contexts[t].sort_buffer = (uint64_t*)malloc(BIRTHDAY_COUNT * sizeof(uint64_t));
+        contexts[t].sort_scratch = (uint64_t*)malloc(BIRTHDAY_COUNT * sizeof(uint64_t));
+        contexts[t].radix_counts = (size_t*)malloc(RADIX_SIZE * sizeof(size_t));
+        contexts[t].feedback_state.selector = config.seed;
+        contexts[t].feedback_state.index = config.phase;
+
+        if (contexts[t].accumulators == NULL || contexts[t].values == NULL || contexts[t].key_buffer == NULL ||
+            contexts[t].sort_buffer == NULL || contexts[t].sort_scratch == NULL || contexts[t].radix_counts == NULL) {
+            fprintf(stderr, "Error: Failed to allocate buffers for worker %d.\n", t);
+            return 1;
+        }
+    }
+
+    struct timespec start_time, end_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+    for (int t = 0; t < config.thread_count; ++t) {
+        if (pthread_create(&threads[t], NULL, run_worker, &contexts[t]) != 0) {
+            fprintf(stderr, "Error: Failed to start worker %d.\n", t);
+            return 1;
+        }
+    }
+    for (int t = 0; t < config.thread_count; ++t) {
+        pthread_join(threads[t], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    double elapsed_seconds = (double)(end_time.tv_sec - start_time.tv_sec) +
+                             (double)(end_time.tv_nsec - start_time.tv_nsec) * 1e-9;
+
+    // --- Merge and report ---
+    static battery_accumulators_t totals;
+    for (int t = 0; t < config.thread_count; ++t) {
+        const battery_accumulators_t* acc = contexts[t].accumulators;
+        for (int pair = 0; pair < BYTE_PAIR_COUNT; ++pair) {
+            for (size_t i = 0; i < HISTOGRAM_BINS; ++i) {
+                totals.byte_pair_histograms[pair][i] += acc->byte_pair_histograms[pair][i];
+            }
+        }
+        for (size_t i = 0; i < HISTOGRAM_BINS; ++i) {
+            totals.serial_pair_histogram[i] += acc->serial_pair_histogram[i];
+        }
+        for (int i = 0; i < GAP_BINS; ++i) {
+            totals.gap_histogram[i] += acc->gap_histogram[i];
+        }
+        totals.birthday_duplicates += acc->birthday_duplicates;
+        totals.birthday_samples += acc->birthday_samples;
+        totals.value_count += acc->value_count;
+
+        free(contexts[t].accumulators);
+        free(contexts[t].values);
+        free(contexts[t].key_buffer);
+        free(contexts[t].sort_buffer);
+        free(contexts[t].sort_scratch);
+        free(contexts[t].radix_counts);
+    }
+    free(contexts);
+    free(threads);
+
+    test_result_t results[16];
+    int result_count = finalize_results(&totals, results);
+    int suspicious_count = 0;
+    int failure_count = 0;
+
+    printf("%-28s %16s %8s %12s  %s\n", "Test", "Statistic", "DoF", "p-value", "Verdict");
+    printf("----------------------------------------------------------------------------\n");
+    for (int i = 0; i < result_count; ++i) {
+        double p = results[i].p_value;
+        const char* verdict = classify_p_value(p);
+
+        if (strcmp(verdict, "FAIL") == 0) {
+            failure_count++;
+        } else if (strcmp(verdict, "suspicious") == 0) {
+            suspicious_count++;
+        }
+
+        printf("%-28s %16.2f %8.0f %12.6g  %s\n", results[i].name, results[i].statistic,
+               results[i].degrees_of_freedom, p, verdict);
+    }
+    printf("----------------------------------------------------------------------------\n\n");
+
+    printf("========================================\n");
+    printf(" Processed %llu values in %.2f s (%.1f M values/s)\n",
+           (unsigned long long)totals.value_count, elapsed_seconds, (double)totals.value_count / elapsed_seconds / 1e6);
+    printf(" Suspicious: %d, Failed: %d\n", suspicious_count, failure_count);
+    printf("========================================\n");
+
+    return failure_count == 0 ? 0 : 2;
+}